@@ -0,0 +1,165 @@
+#include <iostream>
+#include <fstream>
+#include "batch.h"
+#include <csignal>
+#include <string>
+#include <sstream>
+
+// Run rows of a parameter grid (params.txt or an input CSV file) in one
+// process. Takes the grid file and the rows to run ("all", or indices and
+// ranges such as "3,5-9"), then the lattice type, sweep limit, sweep schedule,
+// timeout, greedy, correlated and sweep rate arguments of SweepDecoder and its
+// optional in place, stall patience and abort weight arguments. A sweep limit
+// or timeout of 0 uses the data_generator.py default for each row's L.
+// Optionally a row stops early once the 95% interval on its failure rate is
+// narrower than an absolute width or a fraction of the rate, or after a
+// number of failures (each 0 to disable). Each row is written to the JSON
+// file data_generator.py would write for it, or, given a further argument,
+// appended to that result stream (see resultStream.h and read_results.py).
+// With a stream, a checkpoint file and an interval in seconds (default 600)
+// may follow. The run is then saved at that interval and on SIGTERM or
+// SIGINT, which also stop it with exit code 75 (EX_TEMPFAIL), and the same
+// command carries on from the checkpoint.
+void requestCheckpoint(int)
+{
+    checkpointSignal = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 10)
+    {
+        std::cout << "Fewer than nine arguments" << std::endl;
+        for (int i = 0; i < argc; ++i)
+        {
+            std::cout << "Argument " << i << " = " << argv[i] << std::endl;
+        }
+        return 1;
+    }
+
+    std::ifstream gridFile(argv[1]);
+    if (!gridFile)
+    {
+        std::cerr << "Cannot open grid file " << argv[1] << "." << std::endl;
+        return 1;
+    }
+    std::stringstream gridText;
+    gridText << gridFile.rdbuf();
+    std::vector<gridRow> rows = readGrid(gridText);
+    vint selection = selectRows(argv[2], rows.size());
+
+    runParameters common;
+    common.l = 0;
+    common.p = 0;
+    common.q = 0;
+    common.latticeType = argv[3];
+    common.sweepLimit = std::atoi(argv[4]);
+    common.sweepSchedule = argv[5];
+    common.timeout = std::atoi(argv[6]);
+    std::stringstream ssg(argv[7]);
+    if (!(ssg >> std::boolalpha >> common.greedy))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    std::stringstream ssc(argv[8]);
+    if (!(ssc >> std::boolalpha >> common.correlatedErrors))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    common.sweepRate = std::atoi(argv[9]);
+    if (argc > 10)
+    {
+        std::stringstream ssi(argv[10]);
+        if (!(ssi >> std::boolalpha >> common.inPlace))
+        {
+            std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+            return 1;
+        }
+    }
+    if (argc > 11)
+    {
+        common.stallPatience = std::atoi(argv[11]);
+    }
+    if (argc > 12)
+    {
+        common.abortWeight = std::atof(argv[12]);
+    }
+    stoppingRule stopping;
+    if (argc > 13)
+    {
+        stopping.absoluteWidth = std::atof(argv[13]);
+    }
+    if (argc > 14)
+    {
+        stopping.relativeWidth = std::atof(argv[14]);
+    }
+    if (argc > 15)
+    {
+        stopping.failureLimit = std::atoi(argv[15]);
+    }
+    // A checkpoint only resumes the run with the same arguments and grid
+    std::string config = gridText.str();
+    for (int i = 2; i < argc && i < 17; ++i)
+    {
+        config += std::string(" ") + argv[i];
+    }
+    std::unique_ptr<Checkpointer> checkpointer;
+    checkpointState resume;
+    bool resuming = false;
+    if (argc > 17)
+    {
+        // The stream holds the finished trials, the checkpoint only counts them
+        if (std::string(argv[16]).empty())
+        {
+            std::cerr << "A checkpoint needs a result stream." << std::endl;
+            return 1;
+        }
+        checkpointer = std::make_unique<Checkpointer>(argv[17], argc > 18 ? std::atof(argv[18]) : 600, configHash(config));
+        resuming = checkpointer->load(resume);
+        std::signal(SIGTERM, requestCheckpoint);
+        std::signal(SIGINT, requestCheckpoint);
+    }
+    std::unique_ptr<ResultStream> stream;
+    if (argc > 16)
+    {
+        stream = std::make_unique<ResultStream>(argv[16], resuming ? static_cast<long long>(resume.streamLength) : -1);
+    }
+
+    // Rows of the same L share one code, so its lattice tables are built once
+    codeCache cache;
+    for (int k = resuming ? resume.position : 0; k < static_cast<int>(selection.size()); ++k)
+    {
+        const int i = selection[k];
+        batchResult batch;
+        try
+        {
+            batch = runGridRow(common, rows[i], cache, stopping, stream.get(), checkpointer.get(), k,
+                               resuming && k == resume.position ? &resume : nullptr);
+        }
+        catch (const checkpointInterrupt &interrupt)
+        {
+            std::cerr << interrupt.what() << std::endl;
+            return 75; // EX_TEMPFAIL, the run is not finished
+        }
+        if (!stream)
+        {
+            std::ofstream output(batchFileName(batch));
+            writeBatchJson(output, batch);
+        }
+        std::cout << i << ", " // Row
+                  << batch.successes << ", " // Successes
+                  << batch.trials << ", " // Trials used
+                  << batch.lower << ", " // 95% interval on the failure rate
+                  << batch.upper << ", "
+                  << batch.elapsed // "s"
+                  << std::endl;
+    }
+    if (checkpointer)
+    {
+        checkpointer->remove();
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "decoder.h"
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+// Time the decoder kernels on every lattice type, in ns per face, stabiliser
+// or lattice vertex so that sizes can be compared directly. Built with
+// cmake -Dcounters=ON, the error, syndrome and sweep kernels also report the
+// perf counters of their phase per unit (the times then include reading the
+// counters).
+// Usage: SweepKernelBenchmark [l ...] (default 8 16 32 64)
+
+// Seconds per call of kernel, with reset run untimed before each call. Calls
+// repeat for at least five calls and minimumSeconds, resets included, and
+// the phase counters start from zero.
+double timePerCall(const std::function<void()> &reset, const std::function<void()> &kernel, int *callsMade = nullptr,
+                   const double minimumSeconds = 0.05)
+{
+    resetPhaseTimers();
+    double seconds = 0;
+    int calls = 0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    while (calls < 5 || std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count() < minimumSeconds)
+    {
+        reset();
+        auto start = std::chrono::high_resolution_clock::now();
+        kernel();
+        auto finish = std::chrono::high_resolution_clock::now();
+        seconds += std::chrono::duration<double>(finish - start).count();
+        ++calls;
+    }
+    if (callsMade)
+    {
+        *callsMade = calls;
+    }
+    return seconds / calls;
+}
+
+void report(const std::string &latticeType, const int l, const std::string &kernel, const double seconds,
+            const int units, const std::string &unit)
+{
+    std::cout << std::setw(20) << latticeType << std::setw(6) << l << std::setw(24) << kernel
+              << std::setw(12) << std::fixed << std::setprecision(2) << 1e9 * seconds / units
+              << "  ns/" << unit << std::endl;
+}
+
+// Counter events per unit charged to the kernel's phase over calls calls
+void reportCounters(const std::string &latticeType, const int l, const std::string &kernel, const phase kernelPhase,
+                    const int calls, const int units, const std::string &unit)
+{
+#ifdef PHASE_COUNTERS
+    for (int c = 0; c < numberOfCounters; ++c)
+    {
+        const int64_t count = phaseCount(kernelPhase, static_cast<counter>(c));
+        std::cout << std::setw(20) << latticeType << std::setw(6) << l << std::setw(24) << kernel << std::setw(12);
+        if (count < 0)
+        {
+            std::cout << "n/a";
+        }
+        else
+        {
+            std::cout << std::fixed << std::setprecision(3) << static_cast<double>(count) / calls / units;
+        }
+        std::cout << "  " << counterNames[c] << "/" << unit << std::endl;
+    }
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    vint ls = {8, 16, 32, 64};
+    if (argc > 1)
+    {
+        ls.clear();
+        for (int i = 1; i < argc; ++i)
+        {
+            ls.push_back(std::atoi(argv[i]));
+        }
+    }
+    const double p = 0.01;
+    // buildCorrelatedIndices compares every pair of faces, so larger sizes take minutes
+    const int correlatedLimit = 16;
+    const vstr directions = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"};
+    std::cout << std::setw(20) << "lattice" << std::setw(6) << "l" << std::setw(24) << "kernel"
+              << std::setw(12) << "time" << std::endl;
+    for (const int l : ls)
+    {
+        for (const std::string latticeType : {"rhombic_toric", "rhombic_boundaries", "cubic_toric", "cubic_boundaries"})
+        {
+            runParameters params{l, p, p, l, "alternating_XZ", 32 * l, latticeType, false, false, 1};
+            std::unique_ptr<Code> code;
+            auto start = std::chrono::high_resolution_clock::now();
+            code = buildCode(params);
+            auto finish = std::chrono::high_resolution_clock::now();
+            const int faces = code->getNumberOfFaces();
+            const int stabilisers = code->getStabiliserIndices().size();
+            const int vertices = code->getLattice().getVertexToEdges().size();
+            report(latticeType, l, "construction", std::chrono::duration<double>(finish - start).count(), faces, "face");
+
+            vuint64 cleanState;
+            code->snapshot(cleanState);
+            auto clean = [&]() { code->restore(cleanState); };
+            int calls;
+            report(latticeType, l, "generateDataError",
+                   timePerCall(clean, [&]() { code->generateDataError(false); }, &calls), faces, "face");
+            reportCounters(latticeType, l, "generateDataError", phaseDataErrors, calls, faces, "face");
+            report(latticeType, l, "generateMeasError", timePerCall(clean, [&]() { code->generateMeasError(); }, &calls),
+                   stabilisers, "stabiliser");
+            reportCounters(latticeType, l, "generateMeasError", phaseMeasErrors, calls, stabilisers, "stabiliser");
+            // checkCorrection only reads the logical parity, which toggleError keeps up to date
+            report(latticeType, l, "toggleError", timePerCall(clean, [&]()
+                   {
+                       for (int face = 0; face < faces; ++face)
+                       {
+                           code->toggleError(face);
+                       }
+                   }),
+                   faces, "face");
+
+            // One error for the kernels that read it
+            code->generateDataError(false);
+            code->calculateSyndrome();
+            vuint64 errorState;
+            code->snapshot(errorState);
+            auto withError = [&]() { code->restore(errorState); };
+            report(latticeType, l, "calculateSyndrome",
+                   timePerCall(withError, [&]() { code->calculateSyndrome(); }, &calls), faces, "face");
+            reportCounters(latticeType, l, "calculateSyndrome", phaseSyndrome, calls, faces, "face");
+            // A code with nothing to sweep would time an empty loop
+            for (const auto &direction : code->getSweepIndices().empty() ? vstr() : directions)
+            {
+                report(latticeType, l, "sweep " + direction,
+                       timePerCall(withError, [&]() { code->sweep(direction, false); }, &calls), vertices, "vertex");
+                reportCounters(latticeType, l, "sweep " + direction, phaseSweep, calls, vertices, "vertex");
+            }
+
+            if (l <= correlatedLimit)
+            {
+                start = std::chrono::high_resolution_clock::now();
+                code->buildCorrelatedIndices();
+                finish = std::chrono::high_resolution_clock::now();
+                report(latticeType, l, "correlated indices", std::chrono::duration<double>(finish - start).count(),
+                       faces, "face");
+                report(latticeType, l, "generateDataError corr",
+                       timePerCall(clean, [&]() { code->generateDataError(true); }), faces, "face");
+            }
+        }
+    }
+    return 0;
+}
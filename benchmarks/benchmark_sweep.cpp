@@ -0,0 +1,68 @@
+#include "rhombicCode.h"
+#include "cubicCode.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+// Time sweeps of the same error in index order and with tiled traversal.
+// Usage: SweepBenchmark [l ...] (default 16 32 64 128)
+
+double timeSweeps(Code &code, const std::set<int> &initialError, const int repetitions)
+{
+    const vstr directions = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"};
+    double seconds = 0;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        code.setError(initialError);
+        code.calculateSyndrome();
+        auto start = std::chrono::high_resolution_clock::now();
+        code.sweep(directions[r % directions.size()], true);
+        auto finish = std::chrono::high_resolution_clock::now();
+        seconds += std::chrono::duration<double>(finish - start).count();
+    }
+    return seconds / repetitions;
+}
+
+int main(int argc, char *argv[])
+{
+    vint ls = {16, 32, 64, 128};
+    if (argc > 1)
+    {
+        ls.clear();
+        for (int i = 1; i < argc; ++i)
+        {
+            ls.push_back(std::atoi(argv[i]));
+        }
+    }
+    const double p = 0.01;
+    const vint tileSizes = {0, 4, 8, 16};
+    std::cout << std::setw(20) << "lattice" << std::setw(6) << "l" << std::setw(6) << "tile"
+              << std::setw(14) << "ms/sweep" << std::setw(10) << "speedup" << std::endl;
+    for (const int l : ls)
+    {
+        for (const std::string latticeType : {"rhombic_toric", "rhombic_boundaries"})
+        {
+            std::unique_ptr<Code> code = std::make_unique<RhombicCode>(l, p, p, latticeType == "rhombic_boundaries", 1);
+            code->generateDataError(false);
+            const std::set<int> initialError(code->getError().begin(), code->getError().end());
+            const int repetitions = std::max(8, (1 << 22) / (l * l * l));
+            double baseline = 0;
+            for (const int tileSize : tileSizes)
+            {
+                code->setTileSize(tileSize);
+                timeSweeps(*code, initialError, 2); // Warm up
+                double seconds = timeSweeps(*code, initialError, repetitions);
+                if (tileSize == 0)
+                {
+                    baseline = seconds;
+                }
+                std::cout << std::setw(20) << latticeType << std::setw(6) << l << std::setw(6) << tileSize
+                          << std::setw(14) << std::fixed << std::setprecision(4) << 1000 * seconds
+                          << std::setw(10) << std::setprecision(2) << baseline / seconds << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -7,32 +7,79 @@ import time
 import math
 
 
+# Extra output fields of a SweepDecoder built with cmake -Dtimers=ON, in phaseNames order
+phase_names = ['construction', 'correlated indices', 'data errors', 'measurement errors',
+               'syndrome', 'sweep', 'snapshot', 'readout']
+# Then with cmake -Dcounters=ON, each of these for each phase, -1 if unavailable
+counter_names = ['cycles', 'instructions', 'cache misses', 'branch misses', 'page faults']
+
+
 def snake_case_to_CamelCase(word):
     return ''.join(x.capitalize() or '_' for x in word.split('_'))
 
 
-def generate_data(lattice_type, l, p, q, sweep_limit, sweep_schedule, timeout, cycles, trials, job_number, greedy, correlated, sweep_rate):
+def generate_data(lattice_type, l, p, q, sweep_limit, sweep_schedule, timeout, cycles, trials, job_number, greedy, correlated, sweep_rate, in_place=False, stall_patience=0, abort_weight=0):
     cwd = os.getcwd()
     build_directory = '{0}/{1}'.format(cwd, 'build')
 
-    data = {}
-    results = []
-    successes = 0
-    clear_syndromes = 0
+    # cycles may list several horizons, evaluated from the same trajectories, or
+    # p and q (or sweep_schedule) may list several values, run side by side on
+    # common noise. Each point gets its own output file.
+    horizons = sorted(cycles) if isinstance(cycles, list) else [cycles]
+    p_values = p if isinstance(p, list) else [p]
+    q_values = q if isinstance(q, list) else [q] * len(p_values)
+    schedules = sweep_schedule if isinstance(sweep_schedule, list) else [sweep_schedule]
+    if sum(len(values) > 1 for values in [horizons, p_values, schedules]) > 1:
+        raise ValueError('Only one of cycles, p and sweep_schedule can have several values.')
+    if len(p_values) > 1:
+        points = [(horizons[0], p_k, q_k, schedules[0]) for p_k, q_k in zip(p_values, q_values)]
+    elif len(schedules) > 1:
+        points = [(horizons[0], p_values[0], q_values[0], s) for s in schedules]
+    else:
+        points = [(n, p_values[0], q_values[0], schedules[0]) for n in horizons]
+    results = [[] for _ in points]
+    successes = [0 for _ in points]
+    clear_syndromes = [0 for _ in points]
 
     start_time = time.time()
     for _ in range(trials):
         result = subprocess.run(
-            ['./SweepDecoder', str(l), str(p), str(q), str(cycles), lattice_type, str(sweep_limit), sweep_schedule, str(timeout), str(greedy).lower(), str(correlated).lower(), str(sweep_rate)], stdout=subprocess.PIPE, check=True, cwd=build_directory)
+            ['./SweepDecoder', str(l), ','.join(str(x) for x in p_values), ','.join(str(x) for x in q_values), ','.join(str(n) for n in horizons), lattice_type, str(sweep_limit), ','.join(schedules), str(timeout), str(greedy).lower(), str(correlated).lower(), str(sweep_rate), str(in_place).lower(), str(stall_patience), str(abort_weight)], stdout=subprocess.PIPE, check=True, cwd=build_directory)
         # print(result.stdout.decode('utf-8'))
-        result_list = ast.literal_eval(result.stdout.decode('utf-8'))
-        # print(result_list)
-        results.append(
-            {'Success': result_list[0], 'Clear syndrome': result_list[1], 'Time (s)': result_list[2]})
-        successes += result_list[0]
-        clear_syndromes += result_list[1]
+        for h, line in enumerate(result.stdout.decode('utf-8').splitlines()):
+            result_list = ast.literal_eval(line)
+            # print(result_list)
+            results[h].append(
+                {'Success': result_list[0], 'Clear syndrome': result_list[1], 'Time (s)': result_list[2], 'Readout sweeps': result_list[3], 'Stalled': result_list[4], 'Abort round': result_list[5]})
+            if len(result_list) > 6:
+                results[h][-1]['Phase times (s)'] = dict(zip(phase_names, result_list[6:6 + len(phase_names)]))
+            counts = result_list[6 + len(phase_names):]
+            if counts:
+                results[h][-1]['Phase counters'] = {
+                    name: {event: (None if count < 0 else count)
+                           for event, count in zip(counter_names, counts[k * len(counter_names):])}
+                    for k, name in enumerate(phase_names)}
+            successes[h] += result_list[0]
+            clear_syndromes[h] += result_list[1]
     elapsed_time = round(time.time() - start_time, 2)
 
+    for h, (n, p_h, q_h, schedule) in enumerate(points):
+        # Schedules decoded the same errors, so record the discordant pairs against each other schedule
+        paired = None
+        if len(schedules) > 1:
+            paired = {}
+            for o, other in enumerate(schedules):
+                if o != h:
+                    paired[other] = {'Only this succeeded': sum(a['Success'] and not b['Success'] for a, b in zip(results[h], results[o])),
+                                     'Only other succeeded': sum(b['Success'] and not a['Success'] for a, b in zip(results[h], results[o]))}
+        write_data(lattice_type, l, p_h, q_h, sweep_limit, schedule, timeout, n, trials, job_number, greedy, correlated,
+                   sweep_rate, in_place, stall_patience, abort_weight, results[h], successes[h], clear_syndromes[h], elapsed_time, paired)
+
+
+def write_data(lattice_type, l, p, q, sweep_limit, sweep_schedule, timeout, cycles, trials, job_number, greedy, correlated,
+               sweep_rate, in_place, stall_patience, abort_weight, results, successes, clear_syndromes, elapsed_time, paired=None):
+    data = {}
+
     data['Results'] = results
     data['L'] = l
     data['p'] = p
@@ -44,9 +91,16 @@ def generate_data(lattice_type, l, p, q, sweep_limit, sweep_schedule, timeout, c
     data['Timeout'] = timeout
     data['Successes'] = successes
     data['Clear syndromes'] = clear_syndromes
+    # Stalled trials count as failures although some might have succeeded before the timeout
+    data['Stalled trials'] = sum(result['Stalled'] for result in results)
     data['Greedy'] = greedy
     data['Correlated errors'] = correlated
     data['Sweep rate'] = sweep_rate
+    data['In place'] = in_place
+    data['Stall patience'] = stall_patience
+    data['Abort weight'] = abort_weight
+    if paired is not None:
+        data['Paired outcomes'] = paired
 
     # if lattice_type == 'rhombic_toric':
     #     data['Sweep direction'] = sweep_direction
@@ -79,18 +133,20 @@ if __name__ == "__main__":
                         choices=['cubic_boundaries', 'rhombic_boundaries', 'rhombic_toric', 'cubic_toric'])
     parser.add_argument("l", type=int,
                         help="length of l by l by l lattice")
-    parser.add_argument("p", type=float,
-                        help="data qubit error probability")
-    parser.add_argument("q", type=float,
-                        help="measurement error probability")
-    parser.add_argument("cycles", type=int,
-                        help="number of error correction cycles")
+    parser.add_argument("p", type=str,
+                        help="data qubit error probability, or a comma separated list run on common noise")
+    parser.add_argument("q", type=str,
+                        help="measurement error probability, or a comma separated list matching p")
+    parser.add_argument("cycles", type=str,
+                        help="number of error correction cycles, or a comma separated list evaluated from the same trajectories")
     parser.add_argument("trials", type=int,
                         help="number of trials")
     parser.add_argument("--sweep_limit", type=int,
                         help="number of sweeps per direction in active phase (default: sqrt(l))")
-    parser.add_argument("--sweep_schedule", type=str, default='random', choices=[
-                        'rotating_XY', 'alternating_XY', 'rotating_XZ', 'alternating_XZ', 'rotating_YZ', 'alternating_YZ', 'random', 'const', 'pm_XYZ', 'four_directions'], help="sweep direction schedule (default: random)")
+    schedule_choices = ['rotating_XY', 'alternating_XY', 'rotating_XZ', 'alternating_XZ',
+                        'rotating_YZ', 'alternating_YZ', 'random', 'const', 'pm_XYZ', 'four_directions']
+    parser.add_argument("--sweep_schedule", type=str, default='random',
+                        help="sweep direction schedule, or a comma separated list decoded on the same errors (default: random, choices: {})".format(', '.join(schedule_choices)))
     parser.add_argument("--timeout", type=int,
                         help="max number of sweeps before timeout in readout phase (default: 32*l)")
     # parser.add_argument("--sweep_direction", type=str, default='xyz',
@@ -101,21 +157,32 @@ if __name__ == "__main__":
                         help='use a nearest-neighbour correlated error model (default : False)')
     parser.add_argument("--sweep_rate", type=int, default=1,
                         help="the number of sweeps per stabilizer measurement (default : 1)")
+    parser.add_argument("--in_place", action='store_true',
+                        help="apply flips to the syndrome during each sweep (default : False)")
+    parser.add_argument("--stall_patience", type=int, default=0,
+                        help="readout sweeps without progress before a trial stalls, -1 for one pass through the schedule (default : 0, never stall)")
+    parser.add_argument("--abort_weight", type=float, default=0,
+                        help="syndrome weight, or fraction of stabilisers if below 1, that aborts the active phase as a failure (default : 0, never abort)")
     parser.add_argument("--job", type=int, default=-1,
                         help="job number (default: -1)")
 
     args = parser.parse_args()
     lattice_type = args.lattice_type
     l = args.l
-    p = args.p
-    q = args.q
-    cycles = args.cycles
+    p = [float(x) for x in args.p.split(',')]
+    q = [float(x) for x in args.q.split(',')]
+    if len(q) == 1:
+        q = q * len(p)
+    cycles = [int(n) for n in args.cycles.split(',')]
     trials = args.trials
     sweep_limit = args.sweep_limit
     if sweep_limit == None:
         # sweep_limit = int(round(pow(l, 0.5)))
         sweep_limit = math.ceil(math.log(l))
-    sweep_schedule = args.sweep_schedule
+    sweep_schedule = args.sweep_schedule.split(',')
+    for schedule in sweep_schedule:
+        if schedule not in schedule_choices:
+            parser.error('invalid sweep schedule: {}'.format(schedule))
     timeout = args.timeout
     if timeout == None:
         timeout = 32 * l
@@ -124,6 +191,9 @@ if __name__ == "__main__":
     greedy = args.greedy
     correlated = args.correlated_errors
     sweep_rate = args.sweep_rate
+    in_place = args.in_place
+    stall_patience = args.stall_patience
+    abort_weight = args.abort_weight
 
     generate_data(lattice_type, l, p, q, sweep_limit, sweep_schedule,
-                  timeout, cycles, trials, job_number, greedy, correlated, sweep_rate)
+                  timeout, cycles, trials, job_number, greedy, correlated, sweep_rate, in_place, stall_patience, abort_weight)
@@ -22,13 +22,13 @@ for rate in rates:
         sweep_limit = (int) (round(math.log(l))) # How many sweeps before changing direction in error suppression phase
         for timeout in timeouts:
             for N in cycles_list:
-                for p in p_list:
-                    q = p # Measurement error probability
-                    start_time = time.time()
-                    data_generator.generate_data(
-                        lattice_type, l, p, q, sweep_limit, sweep_schedules[0], timeout, N, trials, job_number, greedy, correlated, rate)
-                    # Data will be saved as a json file
-                    finish_time = round(time.time() - start_time, 2)
-                    print('l={} p=q={} cycles={} trials={} job done in {} s'.format(
-                        l, p, N, trials, finish_time))
-                    job_number += 1
+                # All p values run side by side on common noise, one json file each
+                q_list = p_list # Measurement error probabilities
+                start_time = time.time()
+                data_generator.generate_data(
+                    lattice_type, l, p_list, q_list, sweep_limit, sweep_schedules[0], timeout, N, trials, job_number, greedy, correlated, rate)
+                # Data will be saved as a json file
+                finish_time = round(time.time() - start_time, 2)
+                print('l={} p=q={} cycles={} trials={} job done in {} s'.format(
+                    l, p_list, N, trials, finish_time))
+                job_number += 1
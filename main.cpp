@@ -1,4 +1,5 @@
 #include <iostream>
+#include <fstream>
 #include "rhombicToricLattice.h"
 #include "code.h"
 #include "decoder.h"
@@ -19,13 +20,59 @@ int main(int argc, char *argv[])
     }
 
     int l = std::atoi(argv[1]);
-    double p = std::atof(argv[2]);
-    double q = std::atof(argv[3]);
+    // p and q may be comma separated lists, run side by side on common noise
+    vdbl pValues, qValues;
+    std::stringstream ssp(argv[2]);
+    std::stringstream ssq(argv[3]);
+    std::string value;
+    while (std::getline(ssp, value, ','))
+    {
+        pValues.push_back(std::atof(value.c_str()));
+    }
+    while (std::getline(ssq, value, ','))
+    {
+        qValues.push_back(std::atof(value.c_str()));
+    }
+    if (qValues.size() == 1)
+    {
+        qValues.resize(pValues.size(), qValues[0]);
+    }
+    if (pValues.size() != qValues.size())
+    {
+        std::cerr << "Provide one q value, or one for each p value." << std::endl;
+        return 1;
+    }
+    double p = pValues[0];
+    double q = qValues[0];
     // std::string sweepDir(argv[4]);
-    int rounds = std::atoi(argv[4]);
+    // Rounds may be a comma separated list of horizons, all evaluated from one trajectory
+    vint horizons;
+    std::stringstream ssr(argv[4]);
+    std::string horizon;
+    while (std::getline(ssr, horizon, ','))
+    {
+        horizons.push_back(std::atoi(horizon.c_str()));
+    }
+    if (pValues.size() > 1 && horizons.size() > 1)
+    {
+        std::cerr << "Several p values need a single number of rounds." << std::endl;
+        return 1;
+    }
     std::string latticeType(argv[5]);
     int sweepLimit = std::atoi(argv[6]);
-    std::string sweepSchedule(argv[7]);
+    // Several comma separated schedules decode the same errors side by side
+    vstr sweepSchedules;
+    std::stringstream sss(argv[7]);
+    while (std::getline(sss, value, ','))
+    {
+        sweepSchedules.push_back(value);
+    }
+    std::string sweepSchedule = sweepSchedules[0];
+    if (sweepSchedules.size() > 1 && (pValues.size() > 1 || horizons.size() > 1))
+    {
+        std::cerr << "Several schedules need a single p value and number of rounds." << std::endl;
+        return 1;
+    }
     int timeout = std::atoi(argv[8]);
     bool greedy;
     std::stringstream ssg(argv[9]);
@@ -41,8 +88,46 @@ int main(int argc, char *argv[])
         std::cerr << "Incorrect argument provided (boolean)." << std::endl;
         return 1;
     }
-    std::vector<bool> succ;
+    std::vector<runResult> results;
     int sweepRate = std::atoi(argv[11]);
+    // Optional twelfth argument, apply flips to the syndrome during the sweep
+    bool inPlace = false;
+    if (argc > 12)
+    {
+        std::stringstream ssi(argv[12]);
+        if (!(ssi >> std::boolalpha >> inPlace))
+        {
+            std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+            return 1;
+        }
+    }
+    // Optional thirteenth argument, readout sweeps allowed without progress (0, the default, disables,
+    // -1 allows one pass through the schedule)
+    int stallPatience = 0;
+    if (argc > 13)
+    {
+        stallPatience = std::atoi(argv[13]);
+    }
+    // Optional fourteenth argument, syndrome weight (or fraction of stabilisers) that aborts the active phase (0 disables)
+    double abortWeight = 0;
+    if (argc > 14)
+    {
+        abortWeight = std::atof(argv[14]);
+    }
+    // Optional fifteenth argument, file to write the error weight, syndrome weight, faces flipped and sweep
+    // direction of every round to (CSV if it ends in .csv, otherwise binary, see roundRecorder.cpp)
+    std::unique_ptr<RoundRecorder> recorder;
+    if (argc > 15)
+    {
+        if (pValues.size() > 1 || sweepSchedules.size() > 1)
+        {
+            std::cerr << "Rounds are only recorded for a single p value and schedule." << std::endl;
+            return 1;
+        }
+        // Room for the whole trial: the active rounds and a full readout from each horizon
+        int capacity = *std::max_element(horizons.begin(), horizons.end()) + horizons.size() * std::max(timeout, 0);
+        recorder = std::make_unique<RoundRecorder>(std::max(capacity, 1));
+    }
 
     auto start = std::chrono::high_resolution_clock::now();
     // if (latticeType == "rhombic_toric")
@@ -53,7 +138,20 @@ int main(int argc, char *argv[])
     if (latticeType == "rhombic_boundaries" || latticeType == "cubic_boundaries" || latticeType == "rhombic_toric" || latticeType == "cubic_toric")
     {
         // succ = runBoundaries(l, rounds, p, q, sweepLimit, sweepSchedule, timeout, latticeType, greedy, correlatedErrors);
-        succ = oneRun(l, rounds, p, q, sweepLimit, sweepSchedule, timeout, latticeType, greedy, correlatedErrors, sweepRate);
+        runParameters params{l, p, q, sweepLimit, sweepSchedule, timeout, latticeType, greedy,
+                             correlatedErrors, sweepRate, inPlace, stallPatience, abortWeight};
+        if (pValues.size() > 1)
+        {
+            results = commonNoiseRun(params, horizons[0], pValues, qValues);
+        }
+        else if (sweepSchedules.size() > 1)
+        {
+            results = commonNoiseRun(params, horizons[0], sweepSchedules);
+        }
+        else
+        {
+            results = multiHorizonRun(params, horizons, recorder.get());
+        }
     }
     else
     {
@@ -62,10 +160,54 @@ int main(int argc, char *argv[])
     auto finish = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = finish - start;
 
-    std::cout << succ[0] << ", " // Decoding succeeded
-              << succ[1] << ", " // Clean syndrome
-              << elapsed.count() // "s" <<
-              << std::endl;
+    // One line per horizon in ascending order (or per p value or schedule), the time covers the whole trial
+    for (const auto &result : results)
+    {
+        std::cout << result.success << ", " // Decoding succeeded
+                  << result.cleanSyndrome << ", " // Clean syndrome
+                  << elapsed.count() << ", " // "s" <<
+                  << result.readoutSweeps << ", " // Readout sweeps
+                  << result.stalled << ", " // Readout stalled
+                  << result.abortRound; // Active round of an early abort
+#ifdef PHASE_TIMERS
+        // Seconds in each phase of the whole trial, in phaseNames order
+        for (int k = 0; k < numberOfPhases; ++k)
+        {
+            std::cout << ", " << phaseSeconds(static_cast<phase>(k));
+        }
+#endif
+#ifdef PHASE_COUNTERS
+        // Then each counter of each phase, phase by phase in counterNames order, -1 if unavailable
+        for (int k = 0; k < numberOfPhases; ++k)
+        {
+            for (int c = 0; c < numberOfCounters; ++c)
+            {
+                std::cout << ", " << phaseCount(static_cast<phase>(k), static_cast<counter>(c));
+            }
+        }
+#endif
+        std::cout << std::endl;
+    }
+
+    if (recorder)
+    {
+        const std::string recordPath = argv[15];
+        const bool csv = recordPath.size() >= 4 && recordPath.compare(recordPath.size() - 4, 4, ".csv") == 0;
+        std::ofstream recordFile(recordPath, csv ? std::ios::out : std::ios::binary);
+        if (!recordFile)
+        {
+            std::cerr << "Cannot open record file " << recordPath << "." << std::endl;
+            return 1;
+        }
+        if (csv)
+        {
+            recorder->writeCsv(recordFile);
+        }
+        else
+        {
+            recorder->writeBinary(recordFile);
+        }
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+import argparse
+import json
+import struct
+
+
+def read_stream(path):
+    """Yield one dict per complete row of a SweepBatch result stream, in the
+    JSON layout of data_generator.py, with the output file name under 'File'."""
+    trial_format = struct.Struct('<Biif')
+    row = None
+    with open(path, 'rb') as stream:
+        while True:
+            prefix = stream.read(5)
+            if len(prefix) < 5:
+                break
+            length, record_type = struct.unpack('<IB', prefix)
+            payload = stream.read(length)
+            if len(payload) < length:
+                break  # Truncated by an interrupted run
+            record_type = chr(record_type)
+            if record_type == 'M':
+                if not payload.startswith(b'SweepResults'):
+                    raise ValueError('{} is not a result stream'.format(path))
+            elif record_type == 'H':
+                row = json.loads(payload.decode('utf-8'))
+                row['Results'] = []
+            elif record_type == 'T':
+                for flags, readout_sweeps, abort_round, seconds in trial_format.iter_unpack(payload):
+                    row['Results'].append({'Success': flags & 1, 'Clear syndrome': (flags >> 1) & 1, 'Time (s)': seconds,
+                                           'Readout sweeps': readout_sweeps, 'Stalled': (flags >> 2) & 1, 'Abort round': abort_round})
+            elif record_type == 'E':
+                row.update(json.loads(payload.decode('utf-8')))
+                yield row
+                row = None
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Convert a SweepBatch result stream to the JSON files data_generator.py writes.")
+    parser.add_argument("stream", type=str, help="result stream file")
+    parser.add_argument("--summary", action='store_true',
+                        help="print one line per row instead of writing JSON files (default : False)")
+    args = parser.parse_args()
+
+    for data in read_stream(args.stream):
+        json_file = data.pop('File')
+        if args.summary:
+            print('{}: {}/{}'.format(json_file, data['Successes'], data['Trials']))
+        else:
+            with open(json_file, 'w') as output:
+                json.dump(data, output)
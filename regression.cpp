@@ -0,0 +1,99 @@
+#include <iostream>
+#include <fstream>
+#include "regression.h"
+#include <string>
+
+// Run the seeded configurations of a golden file (see regression.h and
+// regression/golden.csv) and check each against its golden success count and
+// the trials per second stored in a baseline file. Takes the golden file, the
+// baseline file, then optionally the tolerance on throughput as a fraction of
+// the baseline (default 0.2), the cases to run ("all", or indices and ranges
+// such as "0,2-3") and what to update from this run: "none" (the default),
+// "baseline" to rewrite the baseline, or "all" to also rewrite the golden
+// counts. Exits with 1 if any count differs or any case is slower than the
+// tolerance allows, unless updating.
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "Fewer than two arguments" << std::endl;
+        for (int i = 0; i < argc; ++i)
+        {
+            std::cout << "Argument " << i << " = " << argv[i] << std::endl;
+        }
+        return 1;
+    }
+    std::string goldenPath = argv[1];
+    std::string baselinePath = argv[2];
+    double tolerance = argc > 3 ? std::atof(argv[3]) : 0.2;
+    std::string update = argc > 5 ? argv[5] : "none";
+    if (update != "none" && update != "baseline" && update != "all")
+    {
+        std::cerr << "Update must be none, baseline or all." << std::endl;
+        return 1;
+    }
+
+    std::ifstream goldenFile(goldenPath);
+    if (!goldenFile)
+    {
+        std::cerr << "Cannot open golden file " << goldenPath << "." << std::endl;
+        return 1;
+    }
+    std::vector<regressionCase> cases = readRegressionCases(goldenFile);
+    goldenFile.close();
+    // A missing baseline (such as on a new machine) only skips the throughput check
+    std::map<std::string, double> baseline;
+    std::ifstream baselineFile(baselinePath);
+    if (baselineFile)
+    {
+        baseline = readBaseline(baselineFile);
+    }
+    baselineFile.close();
+    vint selection = selectRows(argc > 4 ? argv[4] : "all", cases.size());
+
+    // One line per case: name, successes, golden successes, trials per
+    // second, baseline trials per second, verdict
+    bool regressed = false;
+    for (int i : selection)
+    {
+        regressionOutcome outcome = runRegressionCase(cases[i]);
+        compareOutcome(outcome, cases[i], baseline, tolerance);
+        std::string verdict = "ok";
+        if (!outcome.matches)
+        {
+            verdict = cases[i].successes < 0 ? "no golden count" : "results differ";
+        }
+        else if (outcome.slower)
+        {
+            verdict = "slower";
+        }
+        regressed = regressed || !outcome.matches || outcome.slower;
+        std::cout << cases[i].name << ", "
+                  << outcome.successes << ", "
+                  << cases[i].successes << ", "
+                  << outcome.trialsPerSecond << ", "
+                  << outcome.baseline << ", "
+                  << verdict << std::endl;
+        if (update == "all")
+        {
+            cases[i].successes = outcome.successes;
+        }
+        if (update != "none")
+        {
+            baseline[cases[i].name] = outcome.trialsPerSecond;
+        }
+    }
+
+    if (update == "all")
+    {
+        std::ofstream output(goldenPath);
+        writeRegressionCases(output, cases);
+    }
+    if (update != "none")
+    {
+        std::ofstream output(baselinePath);
+        writeBaseline(output, baseline);
+        return 0;
+    }
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include "splitting.h"
+#include <chrono>
+#include <string>
+#include <sstream>
+
+// Estimate a small logical failure rate by multilevel splitting. Takes the
+// first eleven arguments of SweepDecoder, then the splitting levels as a comma
+// separated list of syndrome weights, the trajectories per level and the
+// number of independent replicates.
+int main(int argc, char *argv[])
+{
+    if (argc < 15)
+    {
+        std::cout << "Fewer than fourteen arguments" << std::endl;
+        for (int i = 0; i < argc; ++i)
+        {
+            std::cout << "Argument " << i << " = " << argv[i] << std::endl;
+        }
+        return 1;
+    }
+
+    runParameters params;
+    params.l = std::atoi(argv[1]);
+    params.p = std::atof(argv[2]);
+    params.q = std::atof(argv[3]);
+    int rounds = std::atoi(argv[4]);
+    params.latticeType = argv[5];
+    params.sweepLimit = std::atoi(argv[6]);
+    params.sweepSchedule = argv[7];
+    params.timeout = std::atoi(argv[8]);
+    std::stringstream ssg(argv[9]);
+    if (!(ssg >> std::boolalpha >> params.greedy))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    std::stringstream ssc(argv[10]);
+    if (!(ssc >> std::boolalpha >> params.correlatedErrors))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    params.sweepRate = std::atoi(argv[11]);
+    vint levels;
+    std::stringstream ssl(argv[12]);
+    std::string level;
+    while (std::getline(ssl, level, ','))
+    {
+        levels.push_back(std::atoi(level.c_str()));
+    }
+    int effort = std::atoi(argv[13]);
+    int replicates = std::atoi(argv[14]);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    splittingResult result = splittingRun(params, rounds, levels, effort, replicates);
+    auto finish = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = finish - start;
+
+    std::cout << result.failureRate << ", " // Logical failure rate
+              << result.standardError << ", " // Standard error
+              << result.lower << ", " // 95% confidence interval
+              << result.upper << ", "
+              << result.trajectories << ", " // Trajectories simulated
+              << elapsed.count() // "s"
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "decoder.h"
+#include "resultStream.h"
+#include "checkpoint.h"
+#include "statistics.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+
+// One row of a parameter grid, as written by param_file_generator.py or the input CSV files
+struct gridRow
+{
+    int l;
+    double p;
+    double q; // Equal to p unless the grid has a q column
+    int cycles;
+    int trials;
+    int jobNumber;
+};
+
+// Outcome of every trial of one grid row
+struct batchResult
+{
+    gridRow row;
+    runParameters params;        // Settings the row ran with
+    std::vector<runResult> results; // Kept unless the trials go to a result stream
+    vdbl trialTimes;             // Seconds for each trial
+    int trials = 0;              // Trials run
+    int successes = 0;
+    int cleanSyndromes = 0;
+    int stalled = 0;             // Failures that ran out of stall patience, see readoutPhase
+    double elapsed = 0;          // Seconds for the whole row
+    double lower = 0;            // Wilson interval on the failure rate, at the stopping rule's confidence
+    double upper = 1;
+};
+
+// Wilson score interval for a binomial proportion at the given confidence level
+void wilsonInterval(const int failures, const int trials, double &lower, double &upper, const double confidence = 0.95)
+{
+    if (confidence <= 0 || confidence >= 1)
+    {
+        throw std::invalid_argument("Confidence level must be between 0 and 1.");
+    }
+    if (trials == 0)
+    {
+        lower = 0;
+        upper = 1;
+        return;
+    }
+    const double z = normalQuantile(1 - (1 - confidence) / 2);
+    const double n = trials;
+    const double rate = failures / n;
+    const double denominator = 1 + z * z / n;
+    const double centre = (rate + z * z / (2 * n)) / denominator;
+    const double halfWidth = z * std::sqrt(rate * (1 - rate) / n + z * z / (4 * n * n)) / denominator;
+    lower = std::max(0.0, centre - halfWidth);
+    upper = std::min(1.0, centre + halfWidth);
+}
+
+// Criteria for ending a row early, its trial count then acting as a budget.
+// Each criterion is off at 0. The relative width is taken against the
+// failure rate, so it can only be met once a failure has been seen.
+struct stoppingRule
+{
+    double absoluteWidth = 0; // Stop once the interval is at most this wide
+    double relativeWidth = 0; // Stop once the interval is at most this times the failure rate wide
+    int failureLimit = 0;     // Stop after this many failures
+    double confidence = 0.95; // Of the interval the widths are taken from
+
+    bool done(const int failures, const int trials) const
+    {
+        if (failureLimit > 0 && failures >= failureLimit)
+        {
+            return true;
+        }
+        if (absoluteWidth <= 0 && relativeWidth <= 0)
+        {
+            return false;
+        }
+        double lower, upper;
+        wilsonInterval(failures, trials, lower, upper, confidence);
+        if (absoluteWidth > 0 && upper - lower <= absoluteWidth)
+        {
+            return true;
+        }
+        return relativeWidth > 0 && failures > 0 && upper - lower <= relativeWidth * failures / trials;
+    }
+};
+
+vstr splitFields(const std::string &line, const char delimiter)
+{
+    vstr fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, delimiter))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// Reads either a CSV file with a header naming the columns L, p, cycles,
+// trials, job_number (and optionally q), or params.txt rows of the form
+// "job cycles L p trials" separated by spaces.
+std::vector<gridRow> readGrid(std::istream &input)
+{
+    std::vector<gridRow> rows;
+    std::string line;
+    bool csv = false;
+    std::map<std::string, int> columns;
+    bool firstLine = true;
+    while (std::getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.find_first_not_of(" \t") == std::string::npos)
+        {
+            continue;
+        }
+        if (firstLine && line.find(',') != std::string::npos)
+        {
+            csv = true;
+            vstr names = splitFields(line, ',');
+            for (int i = 0; i < static_cast<int>(names.size()); ++i)
+            {
+                columns[names[i]] = i;
+            }
+            for (const std::string name : {"L", "p", "cycles", "trials", "job_number"})
+            {
+                if (columns.find(name) == columns.end())
+                {
+                    throw std::invalid_argument("Grid file has no " + name + " column.");
+                }
+            }
+            firstLine = false;
+            continue;
+        }
+        firstLine = false;
+        gridRow row;
+        if (csv)
+        {
+            vstr fields = splitFields(line, ',');
+            if (fields.size() < columns.size())
+            {
+                throw std::invalid_argument("Grid row has too few fields: " + line);
+            }
+            row.l = std::stoi(fields[columns["L"]]);
+            row.p = std::stod(fields[columns["p"]]);
+            row.q = columns.count("q") ? std::stod(fields[columns["q"]]) : row.p;
+            row.cycles = std::stoi(fields[columns["cycles"]]);
+            row.trials = std::stoi(fields[columns["trials"]]);
+            row.jobNumber = std::stoi(fields[columns["job_number"]]);
+        }
+        else
+        {
+            std::stringstream ss(line);
+            if (!(ss >> row.jobNumber >> row.cycles >> row.l >> row.p >> row.trials))
+            {
+                throw std::invalid_argument("Grid row is not of the form \"job cycles L p trials\": " + line);
+            }
+            row.q = row.p;
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+// Row indices (from 0, in file order, not counting a header) chosen by a
+// comma separated list of indices and inclusive ranges such as "3,5-9", or "all"
+vint selectRows(const std::string &selection, const int numberOfRows)
+{
+    vint indices;
+    if (selection == "all")
+    {
+        for (int i = 0; i < numberOfRows; ++i)
+        {
+            indices.push_back(i);
+        }
+        return indices;
+    }
+    for (const auto &item : splitFields(selection, ','))
+    {
+        size_t dash = item.find('-', 1);
+        int first = std::stoi(item.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+        if (first < 0 || last < first || last >= numberOfRows)
+        {
+            throw std::invalid_argument("Row selection " + item + " is outside the grid.");
+        }
+        for (int i = first; i <= last; ++i)
+        {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+// One code per lattice size, shared by every row and trial of that size.
+// Each trial starts from the snapshot of the code before any error.
+struct codeCache
+{
+    std::map<int, std::unique_ptr<Code>> codes;
+    std::map<int, vuint64> cleanStates;
+
+    Code &get(const runParameters &params)
+    {
+        auto it = codes.find(params.l);
+        if (it == codes.end())
+        {
+            it = codes.emplace(params.l, buildCode(params)).first;
+            it->second->snapshot(cleanStates[params.l]);
+        }
+        return *it->second;
+    }
+};
+
+void writeSettingsJson(std::ostream &output, const batchResult &batch);
+void writeOutcomeJson(std::ostream &output, const batchResult &batch);
+std::string batchFileName(const batchResult &batch);
+
+// Run the trials of a row, all of them or until the stopping rule is met.
+// Settings not given by the row come from common, where a sweep limit or
+// timeout of 0 picks the data_generator.py default for the row's L
+// (ceil(log(L)) and 32 L). Given a stream, the trials are written to it as
+// they finish instead of being kept in the result. Given a checkpointer, the
+// row (number position in the selection) is saved between trials and active
+// rounds when due, and given resume it carries on from a saved state. A
+// checkpoint holds only counters, the trials themselves being in the stream,
+// so a checkpointer needs a stream.
+batchResult runGridRow(const runParameters &common, const gridRow &row, codeCache &cache,
+                       const stoppingRule &stopping = stoppingRule(), ResultStream *stream = nullptr,
+                       Checkpointer *checkpointer = nullptr, const int position = 0,
+                       const checkpointState *resume = nullptr)
+{
+    if (checkpointer && !stream)
+    {
+        throw std::invalid_argument("Checkpoints need a result stream to hold the finished trials.");
+    }
+    batchResult batch;
+    batch.row = row;
+    runParameters &params = batch.params;
+    params = common;
+    params.l = row.l;
+    params.p = row.p;
+    params.q = row.q;
+    if (params.sweepLimit == 0)
+    {
+        params.sweepLimit = static_cast<int>(std::ceil(std::log(row.l)));
+    }
+    if (params.timeout == 0)
+    {
+        params.timeout = 32 * row.l;
+    }
+    Code &code = cache.get(params);
+    code.setErrorProbabilities(row.p, row.q);
+    const vuint64 &cleanState = cache.cleanStates[row.l];
+    double previousElapsed = 0;
+    if (resume)
+    {
+        // The stream already holds the row's settings and finished trials
+        batch.trials = resume->trials;
+        batch.successes = resume->successes;
+        batch.cleanSyndromes = resume->cleanSyndromes;
+        batch.stalled = resume->stalled;
+        previousElapsed = resume->elapsed;
+        if (resume->round < 0)
+        {
+            rnEngine = resume->engine;
+        }
+    }
+    else if (stream)
+    {
+        std::stringstream settings;
+        settings << "{\"File\": \"" << batchFileName(batch) << "\", ";
+        writeSettingsJson(settings, batch);
+        settings << "}";
+        stream->beginRow(settings.str());
+    }
+    auto rowStart = std::chrono::high_resolution_clock::now();
+    checkpointState state;
+    state.position = position;
+    while (batch.trials < row.trials)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        // Record the row between trials (round -1) or the trial in flight
+        auto save = [&](const int round, const sweepScheduler *schedule)
+        {
+            if (!checkpointer || !checkpointer->due())
+            {
+                return;
+            }
+            state.trials = batch.trials;
+            state.successes = batch.successes;
+            state.cleanSyndromes = batch.cleanSyndromes;
+            state.stalled = batch.stalled;
+            std::chrono::duration<double> sinceStart = std::chrono::high_resolution_clock::now() - rowStart;
+            state.elapsed = previousElapsed + sinceStart.count();
+            state.streamLength = stream ? stream->length() : 0;
+            state.round = round;
+            state.engine = rnEngine;
+            state.codeState.clear();
+            if (schedule)
+            {
+                code.snapshot(state.codeState, schedule->index, schedule->count);
+            }
+            checkpointer->save(state);
+        };
+        const bool inFlight = resume && resume->round >= 0;
+        if (!inFlight)
+        {
+            save(-1, nullptr);
+            code.restore(cleanState);
+            code.seedRandom(randomSeed());
+        }
+        sweepScheduler schedule(params.sweepSchedule, code);
+        int round = 0;
+        if (inFlight)
+        {
+            rnEngine = resume->engine;
+            code.restore(resume->codeState, schedule.index, schedule.count);
+            round = resume->round;
+        }
+        resume = nullptr;
+        runResult result = resumeRun(code, schedule, params, row.cycles, round,
+                                     [&](const int r) { save(r, &schedule); });
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        if (stream)
+        {
+            stream->addTrial(result, elapsed.count());
+        }
+        else
+        {
+            batch.results.push_back(result);
+            batch.trialTimes.push_back(elapsed.count());
+        }
+        ++batch.trials;
+        batch.successes += result.success;
+        batch.cleanSyndromes += result.cleanSyndrome;
+        batch.stalled += result.stalled;
+        if (stopping.done(batch.trials - batch.successes, batch.trials))
+        {
+            break;
+        }
+    }
+    wilsonInterval(batch.trials - batch.successes, batch.trials, batch.lower, batch.upper, stopping.confidence);
+    std::chrono::duration<double> rowElapsed = std::chrono::high_resolution_clock::now() - rowStart;
+    batch.elapsed = previousElapsed + rowElapsed.count();
+    if (stream)
+    {
+        std::stringstream outcome;
+        outcome << "{";
+        writeOutcomeJson(outcome, batch);
+        outcome << "}";
+        stream->endRow(outcome.str());
+    }
+    return batch;
+}
+
+std::vector<batchResult> runGrid(const runParameters &common, const std::vector<gridRow> &rows, const vint &selection,
+                                 const stoppingRule &stopping = stoppingRule())
+{
+    codeCache cache;
+    std::vector<batchResult> batches;
+    for (int i : selection)
+    {
+        batches.push_back(runGridRow(common, rows[i], cache, stopping));
+    }
+    return batches;
+}
+
+// As snake_case_to_CamelCase in data_generator.py
+std::string snakeToCamelCase(const std::string &word)
+{
+    std::string camel;
+    for (const auto &part : splitFields(word, '_'))
+    {
+        if (part.empty())
+        {
+            camel += '_';
+            continue;
+        }
+        camel += static_cast<char>(std::toupper(part[0]));
+        for (size_t i = 1; i < part.size(); ++i)
+        {
+            camel += static_cast<char>(std::tolower(part[i]));
+        }
+    }
+    return camel;
+}
+
+// Output file name used by data_generator.py for the same data point
+std::string batchFileName(const batchResult &batch)
+{
+    const runParameters &params = batch.params;
+    char name[512];
+    std::snprintf(name, sizeof(name),
+                  "L=%d_N=%d_p=%0.4f_q=%0.4f_schedule=%s_sweepLimit=%d_timeout=%d_lattice=%s_correlated=%s_rate=%d_trials=%d_job=%d.json",
+                  params.l, batch.row.cycles, params.p, params.q, snakeToCamelCase(params.sweepSchedule).c_str(),
+                  params.sweepLimit, params.timeout, snakeToCamelCase(params.latticeType).c_str(),
+                  params.correlatedErrors ? "True" : "False", params.sweepRate, batch.row.trials, batch.row.jobNumber);
+    return name;
+}
+
+// Keys of the data_generator.py JSON known before the trials run
+void writeSettingsJson(std::ostream &output, const batchResult &batch)
+{
+    const runParameters &params = batch.params;
+    output << std::boolalpha
+           << "\"L\": " << params.l
+           << ", \"p\": " << params.p
+           << ", \"q\": " << params.q
+           << ", \"Cycles\": " << batch.row.cycles
+           << ", \"Trial budget\": " << batch.row.trials
+           << ", \"Lattice Type\": \"" << params.latticeType << "\""
+           << ", \"Timeout\": " << params.timeout
+           << ", \"Greedy\": " << params.greedy
+           << ", \"Correlated errors\": " << params.correlatedErrors
+           << ", \"Sweep rate\": " << params.sweepRate
+           << ", \"In place\": " << params.inPlace
+           << ", \"Stall patience\": " << params.stallPatience
+           << ", \"Abort weight\": " << params.abortWeight
+           << ", \"Sweep limit\": " << params.sweepLimit
+           << ", \"Sweep schedule\": \"" << params.sweepSchedule << "\""
+           << std::noboolalpha;
+}
+
+// Keys of the data_generator.py JSON that summarise the trials
+void writeOutcomeJson(std::ostream &output, const batchResult &batch)
+{
+    output << "\"Trials\": " << batch.trials
+           << ", \"Job RunTime (s)\": " << std::round(batch.elapsed * 100) / 100
+           << ", \"Successes\": " << batch.successes
+           << ", \"Clear syndromes\": " << batch.cleanSyndromes
+           << ", \"Stalled trials\": " << batch.stalled
+           << ", \"Failure rate interval\": [" << batch.lower << ", " << batch.upper << "]";
+}
+
+// The JSON data_generator.py writes for the same data point, so the analysis
+// scripts read batch output unchanged. Trials counts the trials actually run,
+// the trial budget and failure rate interval are extra keys.
+void writeBatchJson(std::ostream &output, const batchResult &batch)
+{
+    output << "{\"Results\": [";
+    for (int t = 0; t < static_cast<int>(batch.results.size()); ++t)
+    {
+        const runResult &result = batch.results[t];
+        output << (t > 0 ? ", " : "")
+               << "{\"Success\": " << static_cast<int>(result.success) // 0 or 1, as SweepDecoder prints it
+               << ", \"Clear syndrome\": " << static_cast<int>(result.cleanSyndrome)
+               << ", \"Time (s)\": " << batch.trialTimes[t]
+               << ", \"Readout sweeps\": " << result.readoutSweeps
+               << ", \"Stalled\": " << static_cast<int>(result.stalled)
+               << ", \"Abort round\": " << result.abortRound << "}";
+    }
+    output << "], ";
+    writeSettingsJson(output, batch);
+    output << ", ";
+    writeOutcomeJson(output, batch);
+    output << "}";
+}
+
+#endif
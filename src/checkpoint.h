@@ -0,0 +1,153 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "decoder.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Set by a signal handler to save a checkpoint at the next opportunity and stop
+volatile std::sig_atomic_t checkpointSignal = 0;
+
+// Thrown once a checkpoint has been saved because of a stop request
+struct checkpointInterrupt : public std::runtime_error
+{
+    checkpointInterrupt() : std::runtime_error("Stopped after saving a checkpoint.") {}
+};
+
+// Everything a batch run needs to carry on where it stopped
+struct checkpointState
+{
+    uint64_t configHash = 0;  // Of the settings, a checkpoint is only used by the same run
+    int position = 0;         // Index into the row selection
+    int trials = 0;           // Counters of the row in progress
+    int successes = 0;
+    int cleanSyndromes = 0;
+    int stalled = 0;
+    double elapsed = 0;
+    uint64_t streamLength = 0; // Result stream bytes covered by the counters
+    int round = -1;           // Active round the trial in flight reached, -1 between trials
+    vuint64 codeState;        // Code snapshot of the trial in flight, with its schedule position
+    pcg32 engine;             // The decoder's own random stream
+};
+
+// FNV-1a, stable between builds unlike std::hash
+uint64_t configHash(const std::string &config)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : config)
+    {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Saves a checkpoint at most every interval seconds, or as soon as a stop is
+// requested. Files are replaced by renaming, so a kill while saving leaves
+// the previous checkpoint intact.
+class Checkpointer
+{
+private:
+  std::string path;
+  double interval;
+  std::chrono::steady_clock::time_point lastSave;
+  static const uint64_t magic = 0x53574350; // "SWCP"
+
+public:
+  uint64_t hash;           // Of the run's settings
+  int interruptAfter = -1; // Testing: act as if signalled after this many saves
+
+  Checkpointer(const std::string &path, const double interval, const uint64_t hash)
+      : path(path), interval(interval), lastSave(std::chrono::steady_clock::now()), hash(hash) {}
+
+  bool due()
+  {
+    std::chrono::duration<double> sinceSave = std::chrono::steady_clock::now() - lastSave;
+    return checkpointSignal || interruptAfter == 0 || sinceSave.count() >= interval;
+  }
+
+  void save(checkpointState &state)
+  {
+    static_assert(sizeof(pcg32) % sizeof(uint64_t) == 0, "pcg32 must fill whole words.");
+    const int engineWords = sizeof(pcg32) / sizeof(uint64_t);
+    vuint64 words = {magic, hash, static_cast<uint64_t>(state.position), static_cast<uint64_t>(state.trials),
+                     static_cast<uint64_t>(state.successes), static_cast<uint64_t>(state.cleanSyndromes),
+                     static_cast<uint64_t>(state.stalled), 0, state.streamLength,
+                     static_cast<uint64_t>(static_cast<int64_t>(state.round))};
+    std::memcpy(&words[7], &state.elapsed, sizeof(double));
+    words.resize(words.size() + engineWords);
+    std::memcpy(&words[words.size() - engineWords], &state.engine, sizeof(pcg32));
+    words.push_back(state.codeState.size());
+    words.insert(words.end(), state.codeState.begin(), state.codeState.end());
+    const std::string temporary = path + ".tmp";
+    {
+      std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+      output.write(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint64_t));
+      if (!output)
+      {
+        throw std::runtime_error("Cannot write checkpoint " + temporary + ".");
+      }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+      throw std::runtime_error("Cannot replace checkpoint " + path + ".");
+    }
+    lastSave = std::chrono::steady_clock::now();
+    if (interruptAfter > 0)
+    {
+      --interruptAfter;
+    }
+    if (checkpointSignal || interruptAfter == 0)
+    {
+      throw checkpointInterrupt();
+    }
+  }
+
+  // False if there is no checkpoint to resume from
+  bool load(checkpointState &state)
+  {
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+      return false;
+    }
+    input.seekg(0, std::ios::end);
+    vuint64 words(input.tellg() / sizeof(uint64_t));
+    input.seekg(0);
+    input.read(reinterpret_cast<char *>(words.data()), words.size() * sizeof(uint64_t));
+    const int engineWords = sizeof(pcg32) / sizeof(uint64_t);
+    const int headerWords = 10 + engineWords + 1;
+    if (static_cast<int>(words.size()) < headerWords || words[0] != magic ||
+        words.size() != headerWords + words[headerWords - 1])
+    {
+      throw std::invalid_argument("Checkpoint " + path + " is damaged.");
+    }
+    if (words[1] != hash)
+    {
+      throw std::invalid_argument("Checkpoint " + path + " belongs to a run with different settings.");
+    }
+    state.configHash = words[1];
+    state.position = words[2];
+    state.trials = words[3];
+    state.successes = words[4];
+    state.cleanSyndromes = words[5];
+    state.stalled = words[6];
+    std::memcpy(&state.elapsed, &words[7], sizeof(double));
+    state.streamLength = words[8];
+    state.round = static_cast<int64_t>(words[9]);
+    std::memcpy(static_cast<void *>(&state.engine), &words[10], sizeof(pcg32));
+    state.codeState.assign(words.begin() + headerWords, words.end());
+    return true;
+  }
+
+  // Once the run is complete there is nothing to resume
+  void remove()
+  {
+    std::remove(path.c_str());
+  }
+};
+
+#endif
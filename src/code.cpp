@@ -1,4 +1,5 @@
 #include "code.h"
+#include "phaseTimer.h"
 #include "rhombicToricLattice.h"
 #include "rhombicLattice.h"
 #include <string>
@@ -6,21 +7,15 @@
 #include <random>
 #include <algorithm>
 #include <set>
+#include <numeric>
+#include <cstring>
+#include <type_traits>
 
 Code::Code(const int ll, const double dataP, const double measP, bool boundaries, const int sweepRate) : l(ll),
-                                                                   p(dataP),
-                                                                   q(measP),
                                                                    boundaries(boundaries),
                                                                    sweepRate(sweepRate)
 {
-    if (dataP < 0 || dataP > 1)
-    {
-        throw std::invalid_argument("Data error probability must be between zero and one (inclusive).");
-    }
-    if (measP < 0 || measP > 1)
-    {
-        throw std::invalid_argument("Measurement error probability must be between zero and one (inclusive).");
-    }
+    setErrorProbabilities(dataP, measP);
     pcg_extras::seed_seq_from<std::random_device> seedSource;
     rnEngine = pcg32(seedSource);
     // rnEngine = pcg32(0); // Manual seed
@@ -33,6 +28,7 @@ Code::Code(const int ll, const double dataP, const double measP, bool boundaries
 
 void Code::buildCorrelatedIndices()
 {
+    TIME_PHASE(phaseCorrelatedIndices);
     // correlatedIndices = {};
     correlatedIndices.reserve(numberOfFaces);
     for (int i = 0; i < numberOfFaces; ++i)
@@ -53,8 +49,216 @@ void Code::buildCorrelatedIndices()
     }
 }
 
+void Code::buildStabiliserTables()
+{
+    if (boundaries)
+    {
+        stabiliserIndices.assign(syndromeIndices.begin(), syndromeIndices.end());
+    }
+    else
+    {
+        stabiliserIndices.assign(numberOfEdges, 0);
+        std::iota(std::begin(stabiliserIndices), std::end(stabiliserIndices), 0);
+    }
+    std::vector<int8_t> isStabiliser(numberOfEdges, 0);
+    for (const int edgeIndex : stabiliserIndices)
+    {
+        isStabiliser[edgeIndex] = 1;
+    }
+    faceToStabilisers.assign(faceToEdges.size(), {});
+    for (int i = 0, imax = faceToEdges.size(); i < imax; ++i)
+    {
+        for (const int edgeIndex : faceToEdges[i])
+        {
+            if (isStabiliser[edgeIndex])
+            {
+                faceToStabilisers[i].push_back(edgeIndex);
+            }
+        }
+    }
+}
+
+void Code::buildDirectionToEdge(const vstr &directions)
+{
+    // Edge slots of the original numbering, see Lattice::sparseEdgeIndex
+    const vstr slotDirections = {"xyz", "x", "xy", "y", "yz", "z", "xz"};
+    directionNames = directions;
+    const int numberOfDirections = directions.size();
+    directionToEdge.assign(vertexToEdges.size() * numberOfDirections, -1);
+    for (int vertexIndex = 0, imax = vertexToEdges.size(); vertexIndex < imax; ++vertexIndex)
+    {
+        for (const int edgeIndex : vertexToEdges[vertexIndex])
+        {
+            // Edges are stored at the vertex they point away from
+            const int sparseIndex = lattice->denseToSparseEdge(edgeIndex);
+            std::string direction = slotDirections[sparseIndex % 7];
+            if (sparseIndex / 7 != vertexIndex)
+            {
+                direction = "-" + direction;
+            }
+            auto it = std::find(directions.begin(), directions.end(), direction);
+            if (it != directions.end())
+            {
+                directionToEdge[vertexIndex * numberOfDirections + (it - directions.begin())] = edgeIndex;
+            }
+        }
+    }
+}
+
+void Code::buildDirectionPairToFace()
+{
+    // A face meets each of its vertices along two edges, which name its slot there
+    const int numberOfDirections = directionNames.size();
+    const int numberOfPairs = numberOfDirections * (numberOfDirections - 1) / 2;
+    directionPairSlots.assign(numberOfDirections * numberOfDirections, -1);
+    for (int i = 0, slot = 0; i < numberOfDirections; ++i)
+    {
+        for (int j = i + 1; j < numberOfDirections; ++j, ++slot)
+        {
+            directionPairSlots[i * numberOfDirections + j] = slot;
+            directionPairSlots[j * numberOfDirections + i] = slot;
+        }
+    }
+    directionPairToFace.assign(vertexToEdges.size() * numberOfPairs, -1);
+    const vvint &faceToVertices = lattice->getFaceToVertices();
+    for (int faceIndex = 0, imax = faceToVertices.size(); faceIndex < imax; ++faceIndex)
+    {
+        for (const int vertexIndex : faceToVertices[faceIndex])
+        {
+            const int *edges = &directionToEdge[vertexIndex * numberOfDirections];
+            vint directions;
+            for (int i = 0; i < numberOfDirections; ++i)
+            {
+                if (edges[i] != -1 && std::find(faceToEdges[faceIndex].begin(), faceToEdges[faceIndex].end(), edges[i]) != faceToEdges[faceIndex].end())
+                {
+                    directions.push_back(i);
+                }
+            }
+            if (directions.size() == 2)
+            {
+                directionPairToFace[vertexIndex * numberOfPairs + directionPairSlots[directions[0] * numberOfDirections + directions[1]]] = faceIndex;
+            }
+        }
+    }
+}
+
+void Code::buildUpEdgeTables()
+{
+    upEdgeTables.clear();
+    for (const auto &directionAndUpEdges : upEdgesMap)
+    {
+        const vvint &vertexToUpEdges = directionAndUpEdges.second;
+        vint &table = upEdgeTables[directionAndUpEdges.first];
+        table.assign(4 * vertexToUpEdges.size(), -1);
+        for (int i = 0, imax = vertexToUpEdges.size(); i < imax; ++i)
+        {
+            if (vertexToUpEdges[i].size() > 4)
+            {
+                throw std::length_error("More than four up-edges found for a vertex.");
+            }
+            std::copy(vertexToUpEdges[i].begin(), vertexToUpEdges[i].end(), table.begin() + 4 * i);
+        }
+    }
+}
+
+void Code::tileIndices(vint &indices)
+{
+    if (tileSize <= 0)
+    {
+        std::sort(indices.begin(), indices.end());
+        return;
+    }
+    // Visit whole tileSize^3 bricks (both sub-lattices) one after another,
+    // in index order inside each brick
+    const int bricksPerSide = (l + tileSize - 1) / tileSize;
+    std::vector<std::pair<int, int>> brickAndIndex;
+    brickAndIndex.reserve(indices.size());
+    for (const int vertexIndex : indices)
+    {
+        const cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
+        const int brick = ((coordinate.z / tileSize) * bricksPerSide + coordinate.y / tileSize) * bricksPerSide + coordinate.x / tileSize;
+        brickAndIndex.push_back({brick, vertexIndex});
+    }
+    std::sort(brickAndIndex.begin(), brickAndIndex.end());
+    for (int i = 0, imax = indices.size(); i < imax; ++i)
+    {
+        indices[i] = brickAndIndex[i].second;
+    }
+}
+
+void Code::setTileSize(const int size)
+{
+    if (size < 0)
+    {
+        throw std::invalid_argument("Tile size cannot be negative.");
+    }
+    tileSize = size;
+    tileIndices(sweepIndices);
+}
+
+void Code::setInPlace(const bool inPlaceUpdates)
+{
+    inPlace = inPlaceUpdates;
+}
+
+// Lets one code (and its lattice tables) serve data points that differ only in p and q
+void Code::setErrorProbabilities(const double dataP, const double measP)
+{
+    if (dataP < 0 || dataP > 1)
+    {
+        throw std::invalid_argument("Data error probability must be between zero and one (inclusive).");
+    }
+    if (measP < 0 || measP > 1)
+    {
+        throw std::invalid_argument("Measurement error probability must be between zero and one (inclusive).");
+    }
+    p = dataP;
+    q = measP;
+}
+
+vint &Code::inPlaceOrder(const std::string &direction)
+{
+    auto it = inPlaceOrders.find(direction);
+    if (it != inPlaceOrders.end())
+    {
+        return it->second;
+    }
+    // Sweep direction as a vector, e.g. xy is (1, 1, -1) and -xy is (-1, -1, 1)
+    const bool minus = direction.at(0) == '-';
+    int dx = direction.find('x') != std::string::npos ? 1 : -1;
+    int dy = direction.find('y') != std::string::npos ? 1 : -1;
+    int dz = direction.find('z') != std::string::npos ? 1 : -1;
+    if (minus)
+    {
+        dx = -dx;
+        dy = -dy;
+        dz = -dz;
+    }
+    std::vector<std::pair<int, int>> heightAndIndex;
+    for (const int vertexIndex : sweepIndices)
+    {
+        if (vertexToEdges[vertexIndex].empty())
+        {
+            continue;
+        }
+        // Doubled coordinates so that w = 1 vertices sit half way between w = 0 vertices
+        const cartesian4 c = lattice->indexToCoordinate(vertexIndex);
+        const int height = dx * (2 * c.x + c.w) + dy * (2 * c.y + c.w) + dz * (2 * c.z + c.w);
+        heightAndIndex.push_back({height, vertexIndex});
+    }
+    std::sort(heightAndIndex.begin(), heightAndIndex.end());
+    vint &order = inPlaceOrders[direction];
+    order.reserve(heightAndIndex.size());
+    for (const auto &pair : heightAndIndex)
+    {
+        order.push_back(pair.second);
+    }
+    return order;
+}
+
 void Code::generateDataError(bool correlated)
 {
+    TIME_PHASE(phaseDataErrors);
     // error.clear();
     if (!correlated)
     {
@@ -63,15 +267,7 @@ void Code::generateDataError(bool correlated)
             // if (distDouble0To1(mt) <= p)
             if (distDouble0To1(rnEngine) <= p)
             {
-                auto it = error.find(i);
-                if (it == error.end())
-                {
-                    error.insert(i);
-                }
-                else
-                {
-                    error.erase(it);
-                }
+                toggleError(i);
             }
         }
     }
@@ -86,28 +282,12 @@ void Code::generateDataError(bool correlated)
                 if (twoQubitErrors[0].at(0) == 'x')
                 {
                     // std::cerr << "X on q_i" << std::endl;
-                    auto it = error.find(pair[0]);
-                    if (it == error.end())
-                    {
-                        error.insert(pair[0]);
-                    }
-                    else
-                    {
-                        error.erase(it);
-                    }
+                    toggleError(pair[0]);
                 }
                 if (twoQubitErrors[0].at(1) == 'x')
                 {
                     // std::cerr << "X on q_j" << std::endl;
-                    auto it = error.find(pair[1]);
-                    if (it == error.end())
-                    {
-                        error.insert(pair[1]);
-                    }
-                    else
-                    {
-                        error.erase(it);
-                    }
+                    toggleError(pair[1]);
                 }
             }
         }
@@ -117,15 +297,18 @@ void Code::generateDataError(bool correlated)
 void Code::setError(const std::set<int> &err)
 {
     error.clear();
+    logicalParity = 0;
+    errorKeys = 0;
     for (const int i : err)
     {
-        error.insert(i);
+        toggleError(i);
     }
 }
 
 void Code::setSyndrome(std::vector<int8_t> &synd)
 {
     syndrome = synd;
+    syndromeWeight = std::count_if(syndrome.begin(), syndrome.end(), [](int8_t s) { return s != 0; });
 }
 
 std::vector<int8_t> &Code::getSyndrome()
@@ -138,14 +321,132 @@ Lattice &Code::getLattice()
     return *lattice;
 }
 
-std::set<int> &Code::getError()
+FaceSet &Code::getError()
 {
     return error;
 }
 
+int Code::getSyndromeWeight()
+{
+    return syndromeWeight;
+}
+
+int Code::getNumberOfFaces()
+{
+    return numberOfFaces;
+}
+
+// Snapshot layout in 64 bit words: faces and edges (to check the buffer
+// belongs to this code), schedule position, syndrome weight, logical
+// parity and error hash, RNG, then the error's words and the syndrome's
+// bytes, so both ways are plain copies. The RNG also drives the random
+// sweep schedule. The flips of the last sweep are not stored, restore
+// clears them as if no sweep had run since.
+namespace
+{
+const int snapshotHeaderWords = 7;
+const int rngWords = (sizeof(pcg32) + 7) / 8;
+} // namespace
+
+int Code::snapshotSize()
+{
+    return snapshotHeaderWords + rngWords + error.wordCount() + (numberOfEdges + 7) / 8;
+}
+
+// Copy the complete dynamic state into buffer, which is only reallocated if too small
+void Code::snapshot(vuint64 &buffer, const int sweepIndex, const int sweepCount)
+{
+    TIME_PHASE(phaseSnapshot);
+    static_assert(std::is_trivially_copyable<pcg32>::value, "pcg32 must be trivially copyable.");
+    buffer.assign(snapshotSize(), 0);
+    uint64_t *words = buffer.data();
+    words[0] = numberOfFaces;
+    words[1] = numberOfEdges;
+    words[2] = sweepIndex;
+    words[3] = sweepCount;
+    words[4] = syndromeWeight;
+    words[5] = logicalParity;
+    words[6] = errorKeys;
+    std::memcpy(words + snapshotHeaderWords, &rnEngine, sizeof(pcg32));
+    uint64_t *errorWords = words + snapshotHeaderWords + rngWords;
+    std::memcpy(errorWords, error.data(), error.wordCount() * sizeof(uint64_t));
+    std::memcpy(errorWords + error.wordCount(), syndrome.data(), numberOfEdges);
+}
+
+void Code::restore(const vuint64 &buffer, int &sweepIndex, int &sweepCount)
+{
+    TIME_PHASE(phaseSnapshot);
+    if (static_cast<int>(buffer.size()) != snapshotSize() || buffer[0] != static_cast<uint64_t>(numberOfFaces) ||
+        buffer[1] != static_cast<uint64_t>(numberOfEdges))
+    {
+        throw std::invalid_argument("Snapshot does not match this code.");
+    }
+    const uint64_t *words = buffer.data();
+    sweepIndex = words[2];
+    sweepCount = words[3];
+    syndromeWeight = words[4];
+    logicalParity = words[5];
+    errorKeys = words[6];
+    std::memcpy(static_cast<void *>(&rnEngine), words + snapshotHeaderWords, sizeof(pcg32));
+    const uint64_t *errorWords = words + snapshotHeaderWords + rngWords;
+    std::memcpy(error.data(), errorWords, error.wordCount() * sizeof(uint64_t));
+    error.recount();
+    std::memcpy(syndrome.data(), errorWords + error.wordCount(), numberOfEdges);
+    clearFlippedFaces();
+}
+
+void Code::restore(const vuint64 &buffer)
+{
+    int sweepIndex, sweepCount;
+    restore(buffer, sweepIndex, sweepCount);
+}
+
+// Give a restored copy its own random stream
+void Code::seedRandom(const uint64_t seed)
+{
+    rnEngine = pcg32(seed);
+}
+
+pcg32 &Code::getRandomEngine()
+{
+    return rnEngine;
+}
+
+// Order independent hash of the error, each error face contributes a mixed
+// key that toggleError adds or removes
+uint64_t Code::errorHash()
+{
+    return errorKeys;
+}
+
+// Hash of the random stream the sweep rule breaks ties with, unchanged
+// between two states only if no tie was broken
+uint64_t Code::randomStateHash()
+{
+    uint64_t words[sizeof(pcg32) / sizeof(uint64_t)];
+    std::memcpy(words, &rnEngine, sizeof(pcg32));
+    uint64_t hash = 0;
+    for (const uint64_t word : words)
+    {
+        hash = (hash ^ word) * 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+// Faces the last sweep flipped, applyFlips leaves each of them once in flippedFaces
+int Code::countFacesFlipped()
+{
+    return flipBits.size();
+}
+
 bool Code::checkExtremalVertex(const int vertexIndex, const std::string &direction)
 {
-    auto &upEdges = upEdgesMap[direction][vertexIndex];
+    return checkExtremalVertex(vertexIndex, &upEdgeTables[direction][4 * vertexIndex]);
+}
+
+bool Code::checkExtremalVertex(const int vertexIndex, const int *upEdges)
+{
     auto &edges = vertexToEdges[vertexIndex];
     bool edgeInSyndrome = false;
     for (const int edgeIndex : edges)
@@ -153,7 +454,7 @@ bool Code::checkExtremalVertex(const int vertexIndex, const std::string &directi
         if (syndrome[edgeIndex] == 1)
         {
             edgeInSyndrome = true;
-            if (std::find(upEdges.begin(), upEdges.end(), edgeIndex) == upEdges.end())
+            if (std::find(upEdges, upEdges + 4, edgeIndex) == upEdges + 4)
             {
                 // Edge in syndrome is not an up-edge => vertex is not extremal
                 return false;
@@ -166,8 +467,29 @@ bool Code::checkExtremalVertex(const int vertexIndex, const std::string &directi
 void Code::localFlip(vint &vertices)
 {
     // std::cout << "Attempting local flip ... ";
-    int faceIndex = lattice->findFace(vertices);
-    flipBits[faceIndex] = (flipBits[faceIndex] + 1) % 2;
+    aint4 vertexArray = {vertices[0], vertices[1], vertices[2], vertices[3]};
+    localFlip(vertexArray);
+}
+
+void Code::localFlip(aint4 &vertices)
+{
+    flipFace(lattice->findFace(vertices));
+}
+
+void Code::flipFace(const int faceIndex)
+{
+    const bool flipped = flipBits.toggle(faceIndex);
+    if (inPlace)
+    {
+        for (const int edge : faceToStabilisers[faceIndex])
+        {
+            toggleSyndrome(edge);
+        }
+    }
+    if (flipped)
+    {
+        flippedFaces.push_back(faceIndex);
+    }
     // std::cout << "flipped." << std::endl;
 }
 
@@ -203,7 +525,68 @@ vint Code::faceVertices(const int vertexIndex, vstr directions)
     return vertices;
 }
 
-std::vector<int8_t> &Code::getFlipBits()
+aint4 Code::faceVertices(const int vertexIndex, const std::string &direction0, const std::string &direction1)
+{
+    // Same face as faceVertices(vertexIndex, {direction0, direction1, direction1})
+    // without building vectors, directions are short enough not to allocate
+    const int sign0 = direction0.at(0) == '-' ? -1 : 1;
+    const int sign1 = direction1.at(0) == '-' ? -1 : 1;
+    const std::string unsigned0 = sign0 == 1 ? direction0 : direction0.substr(1);
+    const std::string unsigned1 = sign1 == 1 ? direction1 : direction1.substr(1);
+    int neighbourVertex = lattice->neighbour(vertexIndex, unsigned0, sign0);
+    aint4 vertices = {vertexIndex, neighbourVertex,
+                      lattice->neighbour(vertexIndex, unsigned1, sign1),
+                      lattice->neighbour(neighbourVertex, unsigned1, sign1)};
+    std::sort(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+int Code::spannedFace(const int vertexIndex, const std::string &direction0, const std::string &direction1)
+{
+    // Table lookup for the face faceVertices(vertexIndex, direction0, direction1) names,
+    // -1 where there is none instead of an exception
+    const int numberOfDirections = directionNames.size();
+    const int i = std::find(directionNames.begin(), directionNames.end(), direction0) - directionNames.begin();
+    const int j = std::find(directionNames.begin(), directionNames.end(), direction1) - directionNames.begin();
+    if (i == numberOfDirections || j == numberOfDirections || i == j)
+    {
+        return -1;
+    }
+    const int numberOfPairs = numberOfDirections * (numberOfDirections - 1) / 2;
+    return directionPairToFace[vertexIndex * numberOfPairs + directionPairSlots[i * numberOfDirections + j]];
+}
+
+svstr Code::findSweepEdges(const int vertexIndex, const std::string &direction)
+{
+    return findSweepEdges(vertexIndex, &upEdgeTables[direction][4 * vertexIndex]);
+}
+
+svstr Code::findSweepEdges(const int vertexIndex, const int *upEdges)
+{
+    svstr sweepEdges;
+    const int numberOfDirections = directionNames.size();
+    const int *edges = &directionToEdge[vertexIndex * numberOfDirections];
+    for (int j = 0; j < 4 && upEdges[j] != -1; ++j)
+    {
+        const int edge = upEdges[j];
+        if (syndrome[edge] == 1)
+        {
+            int i = 0;
+            while (i < numberOfDirections && edges[i] != edge)
+            {
+                ++i;
+            }
+            if (i == numberOfDirections)
+            {
+                throw std::invalid_argument("Edge index does not correspond to a valid edge.");
+            }
+            sweepEdges.push_back(directionNames[i]);
+        }
+    }
+    return sweepEdges;
+}
+
+FaceSet &Code::getFlipBits()
 {
     return flipBits;
 }
@@ -211,11 +594,51 @@ std::vector<int8_t> &Code::getFlipBits()
 void Code::clearSyndrome()
 {
     syndrome.assign(numberOfEdges, 0);
+    syndromeWeight = 0;
+}
+
+void Code::toggleSyndrome(const int edge)
+{
+    syndrome[edge] = (syndrome[edge] + 1) % 2;
+    syndromeWeight += syndrome[edge] ? 1 : -1;
 }
 
 void Code::clearFlipBits()
 {
-    flipBits.assign(numberOfFaces, 0);
+    flipBits.clear();
+    flippedFaces.clear();
+}
+
+void Code::clearFlippedFaces()
+{
+    // Only faces flipped by the previous sweep can be set
+    for (const int faceIndex : flippedFaces)
+    {
+        flipBits.erase(faceIndex);
+    }
+    flippedFaces.clear();
+}
+
+void Code::applyFlips()
+{
+    std::sort(flippedFaces.begin(), flippedFaces.end());
+    flippedFaces.erase(std::unique(flippedFaces.begin(), flippedFaces.end()), flippedFaces.end());
+    for (const int faceIndex : flippedFaces)
+    {
+        if (!flipBits.contains(faceIndex))
+        {
+            // Flipped an even number of times
+            continue;
+        }
+        toggleError(faceIndex);
+        if (sweepRate > 1 && !inPlace)
+        {
+            for (const int edge : faceToStabilisers[faceIndex])
+            {
+                toggleSyndrome(edge);
+            }
+        }
+    }
 }
 
 void Code::printUnsatisfiedStabilisers()
@@ -248,6 +671,16 @@ std::set<int> &Code::getSyndromeIndices()
     return syndromeIndices;
 }
 
+vint &Code::getStabiliserIndices()
+{
+    return stabiliserIndices;
+}
+
+vvint &Code::getFaceToStabilisers()
+{
+    return faceToStabilisers;
+}
+
 vint &Code::getSweepIndices()
 {
     return sweepIndices;
@@ -271,85 +704,96 @@ vvint Code::getLogicals()
 
 bool Code::checkCorrection()
 {
-    int parityZ1 = 0, parityZ2 = 0, parityZ3 = 0;
-    for (int faceIndex : logicalZ1)
-    {
-        if (error.find(faceIndex) != error.end())
-        {
-            parityZ1 = (parityZ1 + 1) % 2;
-            // std::cout << faceIndex << std::endl;
-        }
-    }
-    if (parityZ1 % 2 == 1)
+    return logicalParity == 0;
+}
+
+int8_t Code::getLogicalParity()
+{
+    return logicalParity;
+}
+
+// Called at the end of buildLogicals, the error must be empty
+void Code::buildLogicalMembership()
+{
+    logicalMembership.assign(numberOfFaces, 0);
+    for (const int faceIndex : logicalZ1)
     {
-        return false;
+        logicalMembership[faceIndex] ^= 1;
     }
     if (!boundaries)
     {
-        for (int faceIndex : logicalZ2)
+        for (const int faceIndex : logicalZ2)
         {
-            if (error.find(faceIndex) != error.end())
-            {
-                parityZ2 = (parityZ2 + 1) % 2;
-                // std::cout << faceIndex << std::endl;
-            }
-        }
-        if (parityZ2 % 2 == 1)
-        {
-            return false;
-        }
-        for (int faceIndex : logicalZ3)
-        {
-            if (error.find(faceIndex) != error.end())
-            {
-                parityZ3 = (parityZ3 + 1) % 2;
-                // std::cout << faceIndex << std::endl;
-            }
+            logicalMembership[faceIndex] ^= 2;
         }
-        if (parityZ3 % 2 == 1)
+        for (const int faceIndex : logicalZ3)
         {
-            return false;
+            logicalMembership[faceIndex] ^= 4;
         }
     }
-    return true;
+    logicalParity = 0;
+}
+
+void Code::toggleError(const int faceIndex)
+{
+    error.toggle(faceIndex);
+    logicalParity ^= logicalMembership[faceIndex];
+    uint64_t key = faceIndex + 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    errorKeys ^= key ^ (key >> 31);
 }
 
 void Code::calculateSyndrome()
 {
+    TIME_PHASE(phaseSyndrome);
     clearSyndrome();
     for (const int errorIndex : error)
     {
-        auto &edges = faceToEdges[errorIndex];
+        auto &edges = faceToStabilisers[errorIndex];
         for (const int edgeIndex : edges)
         {
-            if (boundaries)
-            {
-                auto it = syndromeIndices.find(edgeIndex);
-                if (it == syndromeIndices.end())
-                {
-                    continue;
-                }
-            }
-            syndrome[edgeIndex] = (syndrome[edgeIndex] + 1) % 2;
+            toggleSyndrome(edgeIndex);
         }
     }
 }
 
 void Code::generateMeasError()
 {
-    for (int i = 0, imax = syndrome.size() ; i < imax; ++i)
+    TIME_PHASE(phaseMeasErrors);
+    for (const int i : stabiliserIndices)
+    {
+        if (distDouble0To1(rnEngine) <= q)
+        {
+            toggleSyndrome(i);
+        }
+    }
+}
+
+// Uncorrelated data errors from one uniform per face, shared between codes so
+// that codes with larger p see a superset of the new errors
+void Code::generateDataError(const vdbl &uniforms)
+{
+    TIME_PHASE(phaseDataErrors);
+    for (int i = 0; i < numberOfFaces; ++i)
     {
-        if (boundaries)
+        if (uniforms[i] <= p)
         {
-            auto it = syndromeIndices.find(i);
-            if (it == syndromeIndices.end())
-            {
-                continue;
-            }
+            toggleError(i);
         }
-        if (distDouble0To1(rnEngine) <= q)
+    }
+}
+
+// Measurement errors from one uniform per stabiliser, in stabiliserIndices order
+void Code::generateMeasError(const vdbl &uniforms)
+{
+    TIME_PHASE(phaseMeasErrors);
+    const int numberOfStabilisers = stabiliserIndices.size();
+    for (int k = 0; k < numberOfStabilisers; ++k)
+    {
+        if (uniforms[k] <= q)
         {
-            syndrome[i] = (syndrome[i] + 1) % 2;
+            toggleSyndrome(stabiliserIndices[k]);
         }
     }
 }
\ No newline at end of file
@@ -2,13 +2,22 @@
 #define CODE_H
 
 #include "lattice.h"
+#include "stackVector.h"
+#include "faceSet.h"
 #include <string>
 #include <set>
 #include <memory>
 #include "pcg_random.hpp"
 #include <random>
+#include <array>
 // #include "gtest/gtest_prod.h"
 
+// Fixed capacity containers used by the sweep so it never allocates
+typedef StackVector<std::string, 4> svstr;
+typedef std::array<std::string, 3> astr3;
+typedef std::array<int, 4> aint4;
+typedef std::vector<uint64_t> vuint64;
+
 class Code
 {
 protected:
@@ -16,21 +25,36 @@ protected:
   int numberOfFaces;
   int numberOfEdges;
   std::vector<int8_t> syndrome;
-  std::vector<int8_t> flipBits;
+  int syndromeWeight = 0; // Unsatisfied stabilisers, kept in step with every change Code makes to syndrome
+  FaceSet flipBits; // Faces the current sweep flips, sized like error
+  vint flippedFaces; // Faces set in flipBits during the current sweep (may repeat)
   std::set<int> syndromeIndices;
+  vint stabiliserIndices; // Compact numbering, stabiliser k is edge stabiliserIndices[k]
   std::unique_ptr<Lattice> lattice;
   std::vector<int> sweepIndices;
   std::map<std::string, vvint> upEdgesMap;
+  std::map<std::string, vint> upEdgeTables; // upEdgesMap flattened to four slots per vertex, padded with -1
   vvint faceToEdges;
+  vvint faceToStabilisers; // faceToEdges without edges that are not stabilisers
   vvint vertexToEdges;
-  std::set<int> error;
-  const double p; // data error probability
-  const double q; // measurement error probability
+  vstr directionNames; // Signed edge directions, in the order findSweepEdges checks them
+  vint directionToEdge; // Edge in each direction of each vertex (or -1), vertex major
+  vint directionPairSlots; // Slot of each ordered pair of distinct directions, the same for both orders
+  vint directionPairToFace; // Face spanned by each pair of directions at each vertex (or -1), vertex major
+  FaceSet error; // Sized to every face by the constructor, so toggling never allocates
+  double p; // data error probability
+  double q; // measurement error probability
   bool boundaries;
   const int sweepRate; // number of sweeps per stabilizer measurement 
+  int tileSize = 0; // Edge length of the bricks the sweep visits vertices in, 0 for index order
+  bool inPlace = false; // Apply each flip to the syndrome as soon as it is made
+  std::map<std::string, vint> inPlaceOrders; // Sweep vertices ordered along each sweep direction
   vint logicalZ1;
   vint logicalZ2;
   vint logicalZ3;
+  std::vector<int8_t> logicalMembership; // Bit k set if the face is in logical k, built by buildLogicals
+  int8_t logicalParity = 0; // Bit k is the parity of the error on logical k
+  uint64_t errorKeys = 0; // XOR of the error faces' keys, kept in step by toggleError for errorHash
   vvint correlatedIndices;
 
   // pcg-random
@@ -47,15 +71,39 @@ public:
   Code(const int latticeLength, const double dataErrorProbability, const double measErrorProbability, bool boundaries, const int sweepRate);
 
   void generateDataError(bool correlated);
+  void generateDataError(const vdbl &uniforms);
   bool checkExtremalVertex(const int vertexIndex, const std::string &direction);
+  bool checkExtremalVertex(const int vertexIndex, const int *upEdges);
   void localFlip(vint &vertices);
+  void localFlip(aint4 &vertices);
+  void flipFace(const int faceIndex);
+  int spannedFace(const int vertexIndex, const std::string &direction0, const std::string &direction1);
   vint faceVertices(const int vertexIndex, vstr directions);
+  aint4 faceVertices(const int vertexIndex, const std::string &direction0, const std::string &direction1);
+  svstr findSweepEdges(const int vertexIndex, const std::string &direction);
+  svstr findSweepEdges(const int vertexIndex, const int *upEdges);
   void clearSyndrome();
+  void toggleSyndrome(const int edge);
+  void toggleError(const int faceIndex);
+  void buildLogicalMembership();
   void clearFlipBits();
+  void clearFlippedFaces();
+  void applyFlips();
   bool checkCorrection();
+  int8_t getLogicalParity();
   void calculateSyndrome();
   void generateMeasError();
+  void generateMeasError(const vdbl &uniforms);
   void buildCorrelatedIndices();
+  void buildStabiliserTables();
+  void buildDirectionToEdge(const vstr &directions);
+  void buildDirectionPairToFace();
+  void buildUpEdgeTables();
+  void tileIndices(vint &indices);
+  virtual void setTileSize(const int tileSize);
+  void setInPlace(const bool inPlace);
+  void setErrorProbabilities(const double p, const double q);
+  vint &inPlaceOrder(const std::string &direction);
 
   // Test methods
   void setSyndrome(std::vector<int8_t> &syndrome);
@@ -66,11 +114,24 @@ public:
   void printError();
 
   // Getter methods
-  std::vector<int8_t> &getFlipBits();
+  FaceSet &getFlipBits();
   std::vector<int8_t> &getSyndrome();
   Lattice &getLattice();
-  std::set<int> &getError();
+  FaceSet &getError();
+  int getSyndromeWeight();
+  int getNumberOfFaces();
+  uint64_t errorHash();
+  uint64_t randomStateHash();
+  int countFacesFlipped();
+  int snapshotSize();
+  void snapshot(vuint64 &buffer, const int sweepIndex = 0, const int sweepCount = 0);
+  void restore(const vuint64 &buffer, int &sweepIndex, int &sweepCount);
+  void restore(const vuint64 &buffer);
+  void seedRandom(const uint64_t seed);
+  pcg32 &getRandomEngine();
   std::set<int> &getSyndromeIndices();
+  vint &getStabiliserIndices();
+  vvint &getFaceToStabilisers();
   vint &getSweepIndices();
   vvint getLogicals();
   
@@ -78,7 +139,6 @@ public:
   virtual void buildSyndromeIndices() = 0;
   virtual void buildSweepIndices() = 0;
   virtual void sweep(const std::string &direction, bool greedy) = 0;
-  virtual vstr findSweepEdges(const int vertexIndex, const std::string &direction) = 0;
   virtual void buildLogicals() = 0;
   virtual ~Code() = default;
 
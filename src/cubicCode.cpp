@@ -1,5 +1,6 @@
 #include "code.h"
 #include "cubicCode.h"
+#include "phaseTimer.h"
 #include "cubicLattice.h"
 #include "cubicToricLattice.h"
 #include <string>
@@ -18,16 +19,21 @@ CubicCode::CubicCode(const int l, const double p, const double q, bool boundarie
         numberOfFaces = 3 * pow(l, 3);
         lattice = std::make_unique<CubicToricLattice>(l);
     }
-    numberOfEdges = 7 * pow(l, 3);
+    numberOfEdges = 3 * pow(l, 3);
     buildSweepIndices();
     syndrome.assign(numberOfEdges, 0);
-    flipBits.assign(numberOfFaces, 0);
+    error.resize(numberOfFaces);
+    flipBits.resize(numberOfFaces);
+    flippedFaces.reserve(numberOfFaces);
     lattice->createFaces();
     lattice->createUpEdgesMap();
     lattice->createVertexToEdges();
     upEdgesMap = lattice->getUpEdgesMap();
     faceToEdges = lattice->getFaceToEdges(); 
     vertexToEdges = lattice->getVertexToEdges();
+    buildStabiliserTables();
+    buildUpEdgeTables();
+    buildDirectionToEdge({"x", "y", "z", "-x", "-y", "-z"});
     buildLogicals();
 }
 
@@ -66,15 +72,16 @@ void CubicCode::buildSweepIndices()
     }
     else
     {
-        sweepIndices.reserve(pow(l, 3));
+        sweepIndices.assign(pow(l, 3), 0);
         std::iota(std::begin(sweepIndices), std::end(sweepIndices), 0);
     }
 }
 
 void CubicCode::sweep(const std::string &direction, bool greedy)
 {
-    clearFlipBits();
-    vstr edgeDirections;
+    TIME_PHASE(phaseSweep);
+    clearFlippedFaces();
+    astr3 edgeDirections;
     if (direction == "xyz")
     {
         edgeDirections = {"x", "y", "z"};
@@ -111,16 +118,18 @@ void CubicCode::sweep(const std::string &direction, bool greedy)
     {
         throw std::invalid_argument("Invalid sweep direction.");
     }
-    for (auto const vertexIndex : sweepIndices)
+    const int *upEdgeTable = upEdgeTables[direction].data();
+    const vint &order = inPlace ? inPlaceOrder(direction) : sweepIndices;
+    for (auto const vertexIndex : order)
     {
         if (!greedy)
         {
-            if (!checkExtremalVertex(vertexIndex, direction))
+            if (!checkExtremalVertex(vertexIndex, upEdgeTable + 4 * vertexIndex))
             {
                 continue;
             }
         }
-        vstr sweepEdges = findSweepEdges(vertexIndex, direction);
+        svstr sweepEdges = findSweepEdges(vertexIndex, upEdgeTable + 4 * vertexIndex);
         if (sweepEdges.size() > 3)
         {
             throw std::length_error("More than three up-edges found for a cubic lattice vertex.");
@@ -131,40 +140,10 @@ void CubicCode::sweep(const std::string &direction, bool greedy)
         }
         cellularAutomatonStep(vertexIndex, sweepEdges, direction, edgeDirections);
     }
-    for (int i = 0, imax = flipBits.size(); i < imax; ++i)
-    {
-        if (flipBits[i])
-        {
-            auto it = error.find(i);
-            if (it != error.end())
-            {
-                error.erase(it);
-            }
-            else
-            {
-                error.insert(i);
-            }
-            if (sweepRate > 1)
-            {
-                for (const int edge : faceToEdges[i])
-                {
-                    // std::cerr << edge << std::endl;
-                    if (boundaries)
-                    {
-                        auto it2 = syndromeIndices.find(edge);
-                        if (it2 == syndromeIndices.end())
-                        {
-                            continue;
-                        }
-                    }
-                    syndrome[edge] = (syndrome[edge] + 1) % 2;
-                }
-            }
-        }
-    }
+    applyFlips();
 }
 
-void CubicCode::cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void CubicCode::cellularAutomatonStep(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     auto &edge0 = upEdgeDirections[0];
     auto &edge1 = upEdgeDirections[1];
@@ -177,10 +156,10 @@ void CubicCode::cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, c
     if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge2) ||
         (sweepEdges[0] == edge2 && sweepEdges[1] == edge0))
     {
-        vint vertices;
+        aint4 vertices;
         try
         {
-            vertices = faceVertices(vertexIndex, {edge0, edge2, edge2});
+            vertices = faceVertices(vertexIndex, edge0, edge2);
             localFlip(vertices);
         }
         catch (const std::invalid_argument &e)
@@ -190,10 +169,10 @@ void CubicCode::cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, c
     else if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge1) ||
              (sweepEdges[0] == edge1 && sweepEdges[1] == edge0))
     {
-        vint vertices;
+        aint4 vertices;
         try
         {
-            vertices = faceVertices(vertexIndex, {edge0, edge1, edge1});
+            vertices = faceVertices(vertexIndex, edge0, edge1);
             localFlip(vertices);
         }
         catch (const std::invalid_argument &e)
@@ -203,10 +182,10 @@ void CubicCode::cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, c
     else if ((sweepEdges[0] == edge1 && sweepEdges[1] == edge2) ||
              (sweepEdges[0] == edge2 && sweepEdges[1] == edge1))
     {
-        vint vertices;
+        aint4 vertices;
         try
         {
-            vertices = faceVertices(vertexIndex, {edge2, edge1, edge1});
+            vertices = faceVertices(vertexIndex, edge2, edge1);
             localFlip(vertices);
         }
         catch (const std::invalid_argument &e)
@@ -219,91 +198,6 @@ void CubicCode::cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, c
     }
 }
 
-vstr CubicCode::findSweepEdges(const int vertexIndex, const std::string &direction)
-{
-    vstr sweepEdges;
-    auto &upEdges = upEdgesMap[direction][vertexIndex];
-    for (const int edge : upEdges)
-    {
-        if (syndrome[edge] == 1)
-        {
-            int xEdge = -1, yEdge = -1, zEdge = -1;
-            int minusXEdge = -1, minusYEdge = -1, minusZEdge = -1;
-            try
-            {
-                xEdge = lattice->edgeIndex(vertexIndex, "x", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                yEdge = lattice->edgeIndex(vertexIndex, "y", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                zEdge = lattice->edgeIndex(vertexIndex, "z", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusXEdge = lattice->edgeIndex(vertexIndex, "x", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusYEdge = lattice->edgeIndex(vertexIndex, "y", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusZEdge = lattice->edgeIndex(vertexIndex, "z", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            if (xEdge == edge)
-            {
-                sweepEdges.push_back("x");
-            }
-            else if (yEdge == edge)
-            {
-                sweepEdges.push_back("y");
-            }
-            else if (zEdge == edge)
-            {
-                sweepEdges.push_back("z");
-            }
-            else if (minusXEdge == edge)
-            {
-                sweepEdges.push_back("-x");
-            }
-            else if (minusYEdge == edge)
-            {
-                sweepEdges.push_back("-y");
-            }
-            else if (minusZEdge == edge)
-            {
-                sweepEdges.push_back("-z");
-            }
-            else
-            {
-                throw std::invalid_argument("Edge index does not correspond to a valid edge.");
-            }
-        }
-    }
-    return sweepEdges;
-}
-
 void CubicCode::buildLogicals()
 {
     for (int i = 0; i < l - 1; ++i)
@@ -345,4 +239,5 @@ void CubicCode::buildLogicals()
             logicalZ3.push_back(lattice->findFace(faceVertices));
         }
     }
+    buildLogicalMembership();
 }
\ No newline at end of file
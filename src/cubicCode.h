@@ -11,10 +11,9 @@ class CubicCode : public Code
     void buildSyndromeIndices();
     void buildSweepIndices();
     void sweep(const std::string &direction, bool greedy);
-    vstr findSweepEdges(const int vertexIndex, const std::string &direction);
     void buildLogicals();
 
-    void cellularAutomatonStep(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
+    void cellularAutomatonStep(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
 
 };
 
@@ -74,6 +74,16 @@ int CubicLattice::neighbour(const int vertexIndex, const std::string &direction,
     }
 }
 
+int CubicLattice::denseEdgeIndex(const int sparseEdgeIndex)
+{
+    return cubicDenseEdgeIndex(sparseEdgeIndex);
+}
+
+int CubicLattice::denseToSparseEdge(const int edgeIndex)
+{
+    return cubicDenseToSparseEdge(edgeIndex);
+}
+
 void CubicLattice::createFaces()
 {
     int faceIndex = 0;
@@ -9,6 +9,8 @@ class CubicLattice : public Lattice
   public:
     CubicLattice(const int l);
     int neighbour(const int vertexIndex, const std::string &direction, const int sign);
+    int denseEdgeIndex(const int sparseEdgeIndex);
+    int denseToSparseEdge(const int edgeIndex);
     void createFaces();
     void createVertexToEdges();
     void createUpEdgesMap();
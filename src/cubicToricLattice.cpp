@@ -51,6 +51,16 @@ int CubicToricLattice::neighbour(const int vertexIndex, const std::string &direc
     return coordinateToIndex(coordinate);
 }
 
+int CubicToricLattice::denseEdgeIndex(const int sparseEdgeIndex)
+{
+    return cubicDenseEdgeIndex(sparseEdgeIndex);
+}
+
+int CubicToricLattice::denseToSparseEdge(const int edgeIndex)
+{
+    return cubicDenseToSparseEdge(edgeIndex);
+}
+
 void CubicToricLattice::createFaces()
 {
     int faceIndex = 0;
@@ -8,6 +8,8 @@ class CubicToricLattice : public Lattice
   public:
     CubicToricLattice(const int l);
     int neighbour(const int vertexIndex, const std::string &direction, const int sign);
+    int denseEdgeIndex(const int sparseEdgeIndex);
+    int denseToSparseEdge(const int edgeIndex);
     void createFaces();
     void createVertexToEdges();
     void createUpEdgesMap();
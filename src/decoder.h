@@ -4,6 +4,9 @@
 #include <string>
 #include "rhombicCode.h"
 #include "cubicCode.h"
+#include "stallDetector.h"
+#include "phaseTimer.h"
+#include "roundRecorder.h"
 #include <algorithm>
 #include <cmath>
 #include "pcg_random.hpp"
@@ -51,157 +54,550 @@ std::uniform_int_distribution<int> distInt0To7(0, 7);
 //     return success;
 // }
 
-std::vector<bool> oneRun(const int l, const int rounds,
-                                const double p, const double q,
-                                const int sweepLimit,
-                                const std::string sweepSchedule,
-                                const int timeout,
-                                const std::string latticeType,
-                                bool greedy,
-                                bool correlatedErrors, 
-                                const int sweepRate)
+struct runResult
+{
+    bool success = false;       // Decoding succeeded
+    bool cleanSyndrome = false; // Syndrome cleared before the timeout
+    int readoutSweeps = 0;      // Sweeps made in the readout phase
+    bool stalled = false;       // Readout ran out of stall patience, counted as a failure
+    int abortRound = -1;        // Active round the syndrome weight passed the abort threshold, -1 if it never did
+};
+
+uint64_t randomSeed()
+{
+    return (static_cast<uint64_t>(rnEngine()) << 32) | rnEngine();
+}
+
+// Settings shared by every trial of one data point
+struct runParameters
 {
-    std::vector<bool> success = {false, false};
+    int l;
+    double p;
+    double q;
+    int sweepLimit;
+    std::string sweepSchedule;
+    int timeout;
+    std::string latticeType;
+    bool greedy;
+    bool correlatedErrors;
+    int sweepRate;
+    bool inPlace = false;
+    int stallPatience = 0;  // Readout sweeps without progress before a trial stalls, 0 never stalls, -1 for one pass through the schedule
+    double abortWeight = 0; // Syndrome weight (or fraction of stabilisers) that aborts the active phase, 0 never aborts
+};
+
+std::unique_ptr<Code> buildCode(const runParameters &params)
+{
+    TIME_PHASE(phaseConstruction);
     std::unique_ptr<Code> code;
-    if (latticeType == "rhombic_boundaries")
+    const int l = params.l;
+    const double p = params.p;
+    const double q = params.q;
+    const int sweepRate = params.sweepRate;
+    if (params.latticeType == "rhombic_boundaries")
     {
         code = std::make_unique<RhombicCode>(l, p, q, true, sweepRate);
     }
-    else if (latticeType == "cubic_boundaries")
+    else if (params.latticeType == "cubic_boundaries")
     {
         code = std::make_unique<CubicCode>(l, p, q, true, sweepRate);
     }
-    else if (latticeType == "rhombic_toric")
+    else if (params.latticeType == "rhombic_toric")
     {
         code = std::make_unique<RhombicCode>(l, p, q, false, sweepRate);
     }
-    else if (latticeType == "cubic_toric")
+    else if (params.latticeType == "cubic_toric")
     {
         code = std::make_unique<CubicCode>(l, p, q, false, sweepRate);
     }
-    if (correlatedErrors)
+    else
+    {
+        throw std::invalid_argument("Invalid lattice type.");
+    }
+    if (params.correlatedErrors)
     {
         code->buildCorrelatedIndices();
     }
-    std::vector<int8_t> &syndrome = code->getSyndrome();
-    vstr sweepDirections = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"}; // Used by random schedule
-    bool randomSchedule = false;
-    int sweepIndex = 0;
-    int sweepCount = 0;
-    if (sweepSchedule == "rotating_XZ")
+    code->setInPlace(params.inPlace);
+    return code;
+}
+
+// Sweep directions of a schedule and the position reached in it. The random
+// schedule draws from the code's engine, so a code snapshot holding the
+// position also fixes the directions that follow.
+struct sweepScheduler
+{
+    vstr directions = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"}; // Used by random schedule
+    bool random = false;
+    int index = 0;
+    int count = 0; // Sweeps made in the current direction
+    pcg32 *engine;
+
+    sweepScheduler(const std::string &sweepSchedule, Code &code) : engine(&code.getRandomEngine())
     {
-        sweepDirections = {"xyz", "xy", "-xz", "yz", "xz", "-yz", "-xyz", "-xy"};
+        if (sweepSchedule == "rotating_XZ")
+        {
+            directions = {"xyz", "xy", "-xz", "yz", "xz", "-yz", "-xyz", "-xy"};
+        }
+        else if (sweepSchedule == "alternating_XZ")
+        {
+            directions = {"xyz", "-xz", "-yz", "-xy", "-xyz", "xz", "yz", "xy"};
+        }
+        else if (sweepSchedule == "rotating_YZ")
+        {
+            directions = {"xyz", "xy", "-yz", "xz", "yz", "-xz", "-xyz", "-xy"};
+        }
+        else if (sweepSchedule == "alternating_YZ")
+        {
+            directions = {"xyz", "-yz", "-xz", "-xy", "-xyz", "yz", "xz", "xy"};
+        }
+        else if (sweepSchedule == "rotating_XY")
+        {
+            directions = {"xyz", "yz", "-xy", "xz", "xy", "-xz", "-xyz", "-yz"};
+        }
+        else if (sweepSchedule == "alternating_XY")
+        {
+            directions = {"xyz", "-xy", "-xz", "-yz", "-xyz", "xy", "xz", "yz"};
+        }
+        else if (sweepSchedule == "random")
+        {
+            random = true;
+            index = distInt0To7(*engine);
+        }
+        else if (sweepSchedule == "const")
+        {
+            directions = {"-xyz"};
+        }
+        else if (sweepSchedule == "pm_XYZ")
+        {
+            directions = {"-xyz", "xyz"};
+        }
+        else if (sweepSchedule == "four_directions")
+        {
+            directions = {"xyz", "xy", "-xz", "yz"};
+        }
+        else
+        {
+            throw std::invalid_argument("Invalid sweep schedule.");
+        }
     }
-    else if (sweepSchedule == "alternating_XZ")
+
+    // Change direction once limit sweeps have been made in the current one
+    void advance(const int limit)
     {
-        sweepDirections = {"xyz", "-xz", "-yz", "-xy", "-xyz", "xz", "yz", "xy"};
+        if (count == limit)
+        {
+            if (random)
+            {
+                index = distInt0To7(*engine);
+            }
+            else
+            {
+                index = (index + 1) % directions.size();
+            }
+            count = 0;
+        }
     }
-    else if (sweepSchedule == "rotating_YZ")
+
+    const std::string &direction()
+    {
+        return directions[index];
+    }
+};
+
+// Syndrome weight that counts as a certain failure, given either as a number
+// of stabilisers or as a fraction of all stabilisers (0 never aborts)
+int abortThreshold(Code &code, const runParameters &params)
+{
+    if (params.abortWeight < 0)
     {
-        sweepDirections = {"xyz", "xy", "-yz", "xz", "yz", "-xz", "-xyz", "-xy"};
+        throw std::invalid_argument("Abort weight must be non-negative.");
     }
-    else if (sweepSchedule == "alternating_YZ")
+    return params.abortWeight >= 1 ? static_cast<int>(params.abortWeight)
+                                   : static_cast<int>(std::ceil(params.abortWeight * code.getStabiliserIndices().size()));
+}
+
+// First half of an active round: new data errors and a perfect syndrome
+void activeRoundErrors(Code &code, sweepScheduler &schedule, const runParameters &params)
+{
+    schedule.advance(params.sweepLimit);
+    code.generateDataError(params.correlatedErrors);
+    code.calculateSyndrome();
+}
+
+// Second half of an active round: measurement errors and the sweeps
+void activeRoundSweeps(Code &code, sweepScheduler &schedule, const runParameters &params,
+                       RoundRecorder *recorder = nullptr)
+{
+    if (params.q > 0)
     {
-        sweepDirections = {"xyz", "-yz", "-xz", "-xy", "-xyz", "yz", "xz", "xy"};
+        // std::cerr << "Generating measurement error." << std::endl;
+        code.generateMeasError();
     }
-    else if (sweepSchedule == "rotating_XY")
+    const int measuredWeight = recorder ? code.getSyndromeWeight() : 0;
+    int facesFlipped = 0;
+    for (int i = 0; i < params.sweepRate; ++i)
     {
-        sweepDirections = {"xyz", "yz", "-xy", "xz", "xy", "-xz", "-xyz", "-yz"};
+        code.sweep(schedule.direction(), params.greedy);
+        if (recorder)
+        {
+            facesFlipped += code.countFacesFlipped();
+        }
     }
-    else if (sweepSchedule == "alternating_XY")
+    if (recorder)
     {
-        sweepDirections = {"xyz", "-xy", "-xz", "-yz", "-xyz", "xy", "xz", "yz"};
+        recorder->recordActive(schedule.direction(), code.getError().size(), measuredWeight, facesFlipped);
     }
-    else if (sweepSchedule == "random")
+    ++schedule.count;
+}
+
+// Readout phase from the schedule position reached by the active phase.
+// Optionally the readout data errors come from shared uniforms, one per face,
+// and every sweep is recorded.
+runResult readoutPhase(Code &code, sweepScheduler schedule, const runParameters &params,
+                       const vdbl *uniforms = nullptr, RoundRecorder *recorder = nullptr)
+{
+    TIME_PHASE(phaseReadout);
+    runResult result;
+    const int l = params.l;
+    // Data errors = measurement errors at readout
+    if (uniforms)
     {
-        randomSchedule = true;
-        sweepIndex = distInt0To7(rnEngine);
+        code.generateDataError(*uniforms);
     }
-    else if (sweepSchedule == "const")
+    else
     {
-        sweepDirections = {"-xyz"};
+        code.generateDataError(params.correlatedErrors);
     }
-    else if (sweepSchedule == "pm_XYZ")
+    code.calculateSyndrome();
+    // code.printUnsatisfiedStabilisers();
+    // -1 allows one pass through every direction in the schedule without progress
+    int stallPatience = params.stallPatience < 0 ? schedule.directions.size() * l : params.stallPatience;
+    // The error, the schedule position and the code's random state (the sweep
+    // rule and the random schedule draw from it, in every mode) determine all
+    // later sweeps, so a repeated state is a cycle that would reach the timeout
+    // without clearing the syndrome. Ending it early changes no outcome, so
+    // repeats are always watched. Running out of patience can end a trial that
+    // would still have succeeded, so those trials are marked stalled.
+    StallDetector stallDetector(stallPatience, true);
+    for (int r = 0; r < params.timeout; ++r)
     {
-        sweepDirections = {"-xyz", "xyz"};
+        schedule.advance(l);
+        code.sweep(schedule.direction(), params.greedy);
+        code.calculateSyndrome();
+        ++result.readoutSweeps;
+        if (recorder)
+        {
+            recorder->recordReadout(result.readoutSweeps, schedule.direction(), code.getError().size(),
+                                    code.getSyndromeWeight(), code.countFacesFlipped());
+        }
+        if (code.getSyndromeWeight() == 0)
+        {
+            // std::cout << "Clean Syndrome" << std::endl;
+            result.success = code.checkCorrection();
+            result.cleanSyndrome = true;
+            break;
+        }
+        const StallDetector::Verdict verdict =
+            stallDetector.update(code.errorHash() ^ code.randomStateHash() ^
+                                     (static_cast<uint64_t>(schedule.index * (l + 1) + schedule.count) << 40),
+                                 code.getSyndromeWeight());
+        if (verdict != StallDetector::progressing)
+        {
+            result.stalled = verdict == StallDetector::noProgress;
+            break;
+        }
+        ++schedule.count;
     }
-    else if (sweepSchedule == "four_directions")
+
+    // Testing
+    // std::cerr << "Error:" << std::endl;
+    // code.printError();
+    // std::cerr << "Unsatisfied stabilizers:" << std::endl;
+    // code.printUnsatisfiedStabilisers();
+
+    return result;
+}
+
+// Run the active phase up to the largest horizon. At each horizon the readout
+// phase runs from a snapshot of the code, which is restored afterwards,
+// giving one result per horizon (in ascending order) from a single trial.
+// The code must have been built for params and start with no error. Given a
+// recorder, the trial's rounds and readout sweeps go to it.
+std::vector<runResult> multiHorizonRun(Code &code, const runParameters &params, vint horizons,
+                                       RoundRecorder *recorder = nullptr)
+{
+    if (horizons.empty())
     {
-        sweepDirections = {"xyz", "xy", "-xz", "yz"};
+        throw std::invalid_argument("At least one horizon is required.");
     }
-    else
+    std::sort(horizons.begin(), horizons.end());
+    if (horizons.front() < 0)
     {
-        throw std::invalid_argument("Invalid sweep schedule.");
+        throw std::invalid_argument("Horizons must be non-negative.");
+    }
+    const int rounds = horizons.back();
+    const int numberOfHorizons = horizons.size();
+    std::vector<runResult> results(numberOfHorizons);
+    sweepScheduler schedule(params.sweepSchedule, code);
+    const int abortAt = abortThreshold(code, params);
+    int nextHorizon = 0;
+    // Restored after each readout, so later horizons see the same trajectory as
+    // a single run
+    vuint64 savedState;
+    if (recorder)
+    {
+        recorder->beginTrial();
     }
-    int numberOfDirections = sweepDirections.size();
-    // std::cerr << "No. of sweep dirs: " << numberOfDirections << std::endl;
     for (int r = 0; r < rounds; ++r)
     {
-        if (sweepCount == sweepLimit)
+        for (; horizons[nextHorizon] == r; ++nextHorizon)
         {
-            if (randomSchedule)
-            {
-                sweepIndex = distInt0To7(rnEngine);
-            }
-            else
+            code.snapshot(savedState);
+            results[nextHorizon] = readoutPhase(code, schedule, params, nullptr, recorder);
+            code.restore(savedState);
+        }
+        activeRoundErrors(code, schedule, params);
+        if (abortAt > 0 && code.getSyndromeWeight() >= abortAt)
+        {
+            // Every horizon not yet reached fails
+            for (; nextHorizon < numberOfHorizons; ++nextHorizon)
             {
-                sweepIndex = (sweepIndex + 1) % numberOfDirections;
+                results[nextHorizon].abortRound = r;
             }
-            sweepCount = 0;
+            return results;
+        }
+        activeRoundSweeps(code, schedule, params, recorder);
+    }
+    // The last horizons can use the trajectory itself
+    for (; nextHorizon < numberOfHorizons - 1; ++nextHorizon)
+    {
+        code.snapshot(savedState);
+        results[nextHorizon] = readoutPhase(code, schedule, params, nullptr, recorder);
+        code.restore(savedState);
+    }
+    results[nextHorizon] = readoutPhase(code, schedule, params, nullptr, recorder);
+    return results;
+}
+
+// A single horizon trial carried on from an active round, as multiHorizonRun
+// would run it. Between rounds, between(round) may record the trial so far.
+template <typename Between>
+runResult resumeRun(Code &code, sweepScheduler &schedule, const runParameters &params, const int rounds, int round,
+                    Between between, RoundRecorder *recorder = nullptr)
+{
+    const int abortAt = abortThreshold(code, params);
+    if (recorder)
+    {
+        recorder->beginTrial(round);
+    }
+    for (; round < rounds; ++round)
+    {
+        between(round);
+        activeRoundErrors(code, schedule, params);
+        if (abortAt > 0 && code.getSyndromeWeight() >= abortAt)
+        {
+            runResult result;
+            result.abortRound = round;
+            return result;
         }
-        code->generateDataError(correlatedErrors);
-        code->calculateSyndrome();
-        if (q > 0)
+        activeRoundSweeps(code, schedule, params, recorder);
+    }
+    return readoutPhase(code, schedule, params, nullptr, recorder);
+}
+
+// As above, on a code of its own
+std::vector<runResult> multiHorizonRun(const runParameters &params, const vint &horizons,
+                                       RoundRecorder *recorder = nullptr)
+{
+    std::unique_ptr<Code> code = buildCode(params);
+    return multiHorizonRun(*code, params, horizons, recorder);
+}
+
+// Trials with different settings driven by the same noise, side by side.
+// Each round draws one uniform per face and one per stabiliser, and every
+// code flips where the uniform is at most its own probability, so new errors
+// are identical for equal p and nested otherwise. All settings must share the
+// lattice. Returns one result per entry of trialParams. In each active round,
+// observe(round, k, code, false) sees code k just before its errors and
+// observe(round, k, code, true) just after them, before it sweeps.
+template <typename Observer>
+std::vector<runResult> commonNoiseRun(const std::vector<runParameters> &trialParams, const int rounds, Observer observe)
+{
+    if (trialParams.empty())
+    {
+        throw std::invalid_argument("At least one set of parameters is required.");
+    }
+    for (const auto &params : trialParams)
+    {
+        if (params.l != trialParams[0].l || params.latticeType != trialParams[0].latticeType ||
+            params.sweepRate != trialParams[0].sweepRate)
         {
-            // std::cerr << "Generating measurement error." << std::endl;
-            code->generateMeasError();
+            throw std::invalid_argument("Common noise needs the same lattice and sweep rate for every trial.");
         }
-        for (int i = 0; i < sweepRate; ++i)
+        if (params.correlatedErrors)
         {
-            code->sweep(sweepDirections[sweepIndex], greedy);
+            throw std::invalid_argument("Common noise is only available for uncorrelated errors.");
         }
-        // std::cerr << "direction=" << sweepDirections[sweepIndex] << std::endl;
-        // std::cerr << "sweepIndex=" << sweepIndex << std::endl;
-        // std::cerr << "sweepCount=" << sweepCount << std::endl;
-        ++sweepCount;
     }
-    code->generateDataError(correlatedErrors); // Data errors = measurement errors at readout
-    code->calculateSyndrome();
-    // code.printUnsatisfiedStabilisers();
-    for (int r = 0; r < timeout; ++r)
+    const int numberOfCodes = trialParams.size();
+    // One code holds the geometry, each trial keeps its own state as a snapshot
+    std::unique_ptr<Code> code = buildCode(trialParams[0]);
+    std::vector<vuint64> states(numberOfCodes);
+    std::vector<sweepScheduler> schedules;
+    vint abortAt;
+    // The sweep rule's own random choices also start from a common stream
+    const uint64_t decoderSeed = randomSeed();
+    vuint64 cleanState;
+    code->snapshot(cleanState);
+    for (int k = 0; k < numberOfCodes; ++k)
+    {
+        code->restore(cleanState);
+        code->seedRandom(decoderSeed);
+        schedules.emplace_back(trialParams[k].sweepSchedule, *code);
+        abortAt.push_back(abortThreshold(*code, trialParams[k]));
+        code->snapshot(states[k]);
+    }
+    std::vector<runResult> results(numberOfCodes);
+    std::vector<bool> running(numberOfCodes, true);
+    pcg32 noiseEngine(randomSeed());
+    std::uniform_real_distribution<double> distUniform(0, nextafter(1, 2)); // As Code::distDouble0To1
+    vdbl dataUniforms(code->getNumberOfFaces());
+    vdbl measUniforms(code->getStabiliserIndices().size());
+    // Switch the code to trial k's state and settings
+    auto select = [&](const int k)
+    {
+        code->restore(states[k]);
+        code->setErrorProbabilities(trialParams[k].p, trialParams[k].q);
+        code->setInPlace(trialParams[k].inPlace);
+    };
+    for (int r = 0; r < rounds; ++r)
     {
-        if (sweepCount == l)
+        for (auto &u : dataUniforms)
         {
-            if (randomSchedule)
+            u = distUniform(noiseEngine);
+        }
+        for (auto &u : measUniforms)
+        {
+            u = distUniform(noiseEngine);
+        }
+        for (int k = 0; k < numberOfCodes; ++k)
+        {
+            if (!running[k])
             {
-                sweepIndex = distInt0To7(rnEngine);
+                continue;
             }
-            else
+            select(k);
+            const runParameters &params = trialParams[k];
+            sweepScheduler &schedule = schedules[k];
+            schedule.advance(params.sweepLimit);
+            observe(r, k, *code, false);
+            code->generateDataError(dataUniforms);
+            code->calculateSyndrome();
+            if (abortAt[k] > 0 && code->getSyndromeWeight() >= abortAt[k])
             {
-                sweepIndex = (sweepIndex + 1) % numberOfDirections;
+                results[k].abortRound = r;
+                running[k] = false;
+                continue;
             }
-            sweepCount = 0;
+            if (params.q > 0)
+            {
+                code->generateMeasError(measUniforms);
+            }
+            observe(r, k, *code, true);
+            for (int i = 0; i < params.sweepRate; ++i)
+            {
+                code->sweep(schedule.direction(), params.greedy);
+            }
+            ++schedule.count;
+            code->snapshot(states[k]);
         }
-        code->sweep(sweepDirections[sweepIndex], greedy);
-        code->calculateSyndrome();
-        if (std::all_of(syndrome.begin(), syndrome.end(), [](int i) { return i == 0; }))
+    }
+    for (auto &u : dataUniforms)
+    {
+        u = distUniform(noiseEngine);
+    }
+    for (int k = 0; k < numberOfCodes; ++k)
+    {
+        if (running[k])
         {
-            // std::cout << "Clean Syndrome" << std::endl;
-            success = {code->checkCorrection(), true};
-            break;
+            select(k);
+            results[k] = readoutPhase(*code, schedules[k], trialParams[k], &dataUniforms);
         }
-        // std::cerr << "r=" << r << std::endl;
-        // std::cerr << "direction=" << sweepDirections[sweepIndex] << std::endl;
-        ++sweepCount;
     }
+    return results;
+}
 
-    // Testing
-    // std::cerr << "Error:" << std::endl;
-    // code.printError();
-    // std::cerr << "Unsatisfied stabilizers:" << std::endl;
-    // code.printUnsatisfiedStabilisers();
+std::vector<runResult> commonNoiseRun(const std::vector<runParameters> &trialParams, const int rounds)
+{
+    return commonNoiseRun(trialParams, rounds, [](const int, const int, Code &, const bool) {});
+}
+
+// Several (p, q) pairs on common noise, one result per pair
+std::vector<runResult> commonNoiseRun(const runParameters &params, const int rounds, const vdbl &pValues,
+                                      const vdbl &qValues)
+{
+    if (pValues.empty() || pValues.size() != qValues.size())
+    {
+        throw std::invalid_argument("Each p value needs a q value.");
+    }
+    std::vector<runParameters> trialParams(pValues.size(), params);
+    for (int k = 0; k < static_cast<int>(pValues.size()); ++k)
+    {
+        trialParams[k].p = pValues[k];
+        trialParams[k].q = qValues[k];
+    }
+    return commonNoiseRun(trialParams, rounds);
+}
+
+// Several sweep schedules decoding the same errors, one result per schedule
+std::vector<runResult> commonNoiseRun(const runParameters &params, const int rounds, const vstr &sweepSchedules)
+{
+    if (sweepSchedules.empty())
+    {
+        throw std::invalid_argument("At least one sweep schedule is required.");
+    }
+    std::vector<runParameters> trialParams(sweepSchedules.size(), params);
+    for (int k = 0; k < static_cast<int>(sweepSchedules.size()); ++k)
+    {
+        trialParams[k].sweepSchedule = sweepSchedules[k];
+    }
+    return commonNoiseRun(trialParams, rounds);
+}
+
+std::vector<runResult> multiHorizonRun(const int l, vint horizons,
+                                const double p, const double q,
+                                const int sweepLimit,
+                                const std::string sweepSchedule,
+                                const int timeout,
+                                const std::string latticeType,
+                                bool greedy,
+                                bool correlatedErrors, 
+                                const int sweepRate,
+                                bool inPlace = false,
+                                int stallPatience = 0,
+                                const double abortWeight = 0)
+{
+    runParameters params{l, p, q, sweepLimit, sweepSchedule, timeout, latticeType, greedy,
+                         correlatedErrors, sweepRate, inPlace, stallPatience, abortWeight};
+    return multiHorizonRun(params, horizons);
+}
 
-    return success;
+runResult oneRun(const int l, const int rounds,
+                                const double p, const double q,
+                                const int sweepLimit,
+                                const std::string sweepSchedule,
+                                const int timeout,
+                                const std::string latticeType,
+                                bool greedy,
+                                bool correlatedErrors, 
+                                const int sweepRate,
+                                bool inPlace = false,
+                                int stallPatience = 0,
+                                const double abortWeight = 0)
+{
+    return multiHorizonRun(l, {rounds}, p, q, sweepLimit, sweepSchedule, timeout, latticeType, greedy,
+                           correlatedErrors, sweepRate, inPlace, stallPatience, abortWeight)[0];
 }
 
 #endif
\ No newline at end of file
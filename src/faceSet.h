@@ -0,0 +1,166 @@
+#ifndef FACE_SET_H
+#define FACE_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Set of face indices stored as one bit per face of the code, sized once so
+// that adding and removing faces never allocates and the whole set can be
+// copied as words. Iterates in increasing face order, as std::set does.
+class FaceSet
+{
+private:
+  std::vector<uint64_t> words;
+  int numberOfFaces = 0;
+  int weight = 0;
+
+public:
+  class const_iterator
+  {
+  private:
+    const FaceSet *faces;
+    int face;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int *pointer;
+    typedef const int &reference;
+
+    const_iterator(const FaceSet *faces, const int face) : faces(faces), face(face) {}
+    const int &operator*() const { return face; }
+    const_iterator &operator++()
+    {
+      face = faces->next(face + 1);
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const const_iterator &other) const { return face == other.face; }
+    bool operator!=(const const_iterator &other) const { return face != other.face; }
+  };
+  typedef const_iterator iterator;
+  typedef int value_type;
+
+  FaceSet() = default;
+  explicit FaceSet(const int faces) { resize(faces); }
+
+  // Empty set over faces 0 to faces - 1
+  void resize(const int faces)
+  {
+    numberOfFaces = faces;
+    words.assign((faces + 63) / 64, 0);
+    weight = 0;
+  }
+
+  // First face of the set at or after face, or the number of faces if none
+  int next(const int face) const
+  {
+    if (face >= numberOfFaces)
+    {
+      return numberOfFaces;
+    }
+    int w = face / 64;
+    uint64_t bits = words[w] & (~uint64_t(0) << (face % 64));
+    while (!bits)
+    {
+      if (++w == static_cast<int>(words.size()))
+      {
+        return numberOfFaces;
+      }
+      bits = words[w];
+    }
+    return 64 * w + __builtin_ctzll(bits);
+  }
+
+  bool contains(const int face) const { return (words[face / 64] >> (face % 64)) & 1; }
+  bool operator[](const int face) const { return contains(face); }
+
+  // Add the face if it is absent and remove it otherwise, returns whether it is now in the set
+  bool toggle(const int face)
+  {
+    uint64_t &word = words[face / 64];
+    const uint64_t bit = uint64_t(1) << (face % 64);
+    word ^= bit;
+    const bool added = word & bit;
+    weight += added ? 1 : -1;
+    return added;
+  }
+
+  std::pair<iterator, bool> insert(const int face)
+  {
+    const bool added = !contains(face);
+    if (added)
+    {
+      toggle(face);
+    }
+    return {iterator(this, face), added};
+  }
+  int erase(const int face)
+  {
+    if (!contains(face))
+    {
+      return 0;
+    }
+    toggle(face);
+    return 1;
+  }
+  iterator find(const int face) const { return contains(face) ? iterator(this, face) : end(); }
+  int count(const int face) const { return contains(face); }
+  void clear()
+  {
+    std::fill(words.begin(), words.end(), 0);
+    weight = 0;
+  }
+
+  int size() const { return weight; }
+  bool empty() const { return weight == 0; }
+  iterator begin() const { return iterator(this, next(0)); }
+  iterator end() const { return iterator(this, numberOfFaces); }
+
+  // The bits themselves, 64 faces per word, for copying the whole set
+  int wordCount() const { return words.size(); }
+  const uint64_t *data() const { return words.data(); }
+  uint64_t *data() { return words.data(); }
+  // Recount the faces after the words were written through data()
+  void recount()
+  {
+    weight = 0;
+    for (const uint64_t word : words)
+    {
+      weight += __builtin_popcountll(word);
+    }
+  }
+};
+
+inline bool operator==(const FaceSet &lhs, const FaceSet &rhs)
+{
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+inline bool operator!=(const FaceSet &lhs, const FaceSet &rhs)
+{
+  return !(lhs == rhs);
+}
+
+inline bool operator==(const FaceSet &lhs, const std::set<int> &rhs)
+{
+  return lhs.size() == static_cast<int>(rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+inline bool operator==(const std::set<int> &lhs, const FaceSet &rhs)
+{
+  return rhs == lhs;
+}
+
+#endif
@@ -41,6 +41,11 @@ int Lattice::coordinateToIndex(const cartesian4 &coordinate)
 }
 
 int Lattice::edgeIndex(const int vertexIndex, const std::string &direction, const int sign)
+{
+    return denseEdgeIndex(sparseEdgeIndex(vertexIndex, direction, sign));
+}
+
+int Lattice::sparseEdgeIndex(const int vertexIndex, const std::string &direction, const int sign)
 {
     if (!(sign == 1 || sign == -1))
     {
@@ -82,6 +87,67 @@ int Lattice::edgeIndex(const int vertexIndex, const std::string &direction, cons
     return edgeIndex;
 }
 
+int Lattice::cubicDenseEdgeIndex(const int sparseEdgeIndex)
+{
+    // Cubic lattices only use the x, y and z slots
+    int slot = sparseEdgeIndex % 7;
+    if (sparseEdgeIndex < 0 || !(slot == 1 || slot == 3 || slot == 5))
+    {
+        throw std::invalid_argument("Edge index does not correspond to a cubic lattice edge.");
+    }
+    return 3 * (sparseEdgeIndex / 7) + (slot - 1) / 2;
+}
+
+int Lattice::cubicDenseToSparseEdge(const int edgeIndex)
+{
+    if (edgeIndex < 0 || edgeIndex >= 3 * l * l * l)
+    {
+        throw std::invalid_argument("Edge index is outside the lattice.");
+    }
+    return 7 * (edgeIndex / 3) + 2 * (edgeIndex % 3) + 1;
+}
+
+// Directions of the even edge slots, which are the rhombic edges
+static const std::string rhombicEdgeDirections[4] = {"xyz", "xy", "yz", "xz"};
+
+int Lattice::rhombicDenseEdgeIndex(const int sparseEdgeIndex, const int fullVertexParity)
+{
+    // Every edge joins a w=1 vertex to a w=0 vertex and each w=1 vertex
+    // has exactly one edge in each of the xyz, xy, yz and xz directions,
+    // so edges are numbered by their w=1 vertex
+    int slot = sparseEdgeIndex % 7;
+    if (sparseEdgeIndex < 0 || slot % 2 == 1)
+    {
+        throw std::invalid_argument("Edge index does not correspond to a rhombic lattice edge.");
+    }
+    int vertexIndex = sparseEdgeIndex / 7;
+    int neighbourIndex = neighbour(vertexIndex, rhombicEdgeDirections[slot / 2], 1);
+    cartesian4 coordinate = indexToCoordinate(vertexIndex);
+    int halfVertex = (coordinate.w == 1) ? vertexIndex : neighbourIndex;
+    cartesian4 fullCoordinate = indexToCoordinate((coordinate.w == 1) ? neighbourIndex : vertexIndex);
+    if ((fullCoordinate.x + fullCoordinate.y + fullCoordinate.z) % 2 != fullVertexParity)
+    {
+        throw std::invalid_argument("Edge contains a w=0 vertex that is not in the lattice.");
+    }
+    return 4 * (halfVertex - l * l * l) + slot / 2;
+}
+
+int Lattice::rhombicDenseToSparseEdge(const int edgeIndex, const int fullVertexParity)
+{
+    if (edgeIndex < 0 || edgeIndex >= 4 * l * l * l)
+    {
+        throw std::invalid_argument("Edge index is outside the lattice.");
+    }
+    int vertexIndex = l * l * l + edgeIndex / 4;
+    int directionIndex = edgeIndex % 4;
+    cartesian4 coordinate = indexToCoordinate(vertexIndex);
+    // w=1 vertices with the parity of the w=0 vertices have +xy, +xz, +yz
+    // and -xyz edges, the others have -xy, -xz, -yz and +xyz edges
+    bool latticeParity = (coordinate.x + coordinate.y + coordinate.z) % 2 == fullVertexParity;
+    int sign = (latticeParity == (directionIndex == 0)) ? -1 : 1;
+    return sparseEdgeIndex(vertexIndex, rhombicEdgeDirections[directionIndex], sign);
+}
+
 void Lattice::addFace(const int vertexIndex, const int faceIndex, const vstr &directions, const vint &signs)
 {
     vint vertices;
@@ -114,15 +180,23 @@ int Lattice::findFace(vint &vertices)
     {
         throw std::invalid_argument("Lattice::findFace, vertex list must contain exactly four vertices.");
     }
-    else if (vertices[0] < 0 || vertices[1] < 0 || vertices[2] < 0 || vertices[3] < 0)
+    std::array<int, 4> vertexArray = {vertices[0], vertices[1], vertices[2], vertices[3]};
+    int faceIndex = findFace(vertexArray);
+    std::copy(vertexArray.begin(), vertexArray.end(), vertices.begin());
+    return faceIndex;
+}
+
+int Lattice::findFace(std::array<int, 4> &vertices)
+{
+    if (vertices[0] < 0 || vertices[1] < 0 || vertices[2] < 0 || vertices[3] < 0)
     {
         throw std::invalid_argument("Lattice::findFace, vertex indices cannot be negative.");
     }
     std::sort(vertices.begin(), vertices.end());
-    auto v0Faces = vertexToFaces[vertices[0]];
+    auto &v0Faces = vertexToFaces[vertices[0]];
     for (const auto &face : v0Faces)
     {
-        if (face.vertices == vertices)
+        if (std::equal(vertices.begin(), vertices.end(), face.vertices.begin()))
         {
             return face.faceIndex;
         }
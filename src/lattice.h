@@ -2,6 +2,7 @@
 #define LATTICE_H
 
 #include <vector>
+#include <array>
 #include <string>
 #include <map>
 #include <iostream>
@@ -56,6 +57,12 @@ protected:
   Lattice(const int l);
   Lattice();
   void addFace(const int vertexIndex, const int faceIndex, const vstr &directions, const vint &signs);
+  // Dense edge numberings shared by each lattice family. Rhombic lattices
+  // differ only in the parity (x + y + z) % 2 of their w=0 vertices.
+  int cubicDenseEdgeIndex(const int sparseEdgeIndex);
+  int cubicDenseToSparseEdge(const int edgeIndex);
+  int rhombicDenseEdgeIndex(const int sparseEdgeIndex, const int fullVertexParity);
+  int rhombicDenseToSparseEdge(const int edgeIndex, const int fullVertexParity);
 
 public:
   virtual ~Lattice() = default;
@@ -63,13 +70,21 @@ public:
   cartesian4 indexToCoordinate(const int vertexIndex);
   int coordinateToIndex(const cartesian4 &coordinate);
   int findFace(vint &vertices);
+  int findFace(std::array<int, 4> &vertices);
   // Find the edge pointing in the sign direction which
   // contains a vertex (index)
   virtual int edgeIndex(const int vertexIndex, const std::string &direction, const int sign);
+  // Original edge numbering, which reserves seven slots per vertex
+  // (xyz, x, xy, y, yz, z, xz) whether or not the edges exist
+  int sparseEdgeIndex(const int vertexIndex, const std::string &direction, const int sign);
   
   // Pure virtual methods
   // Find neighbour of a vertex (index) in the sign direction
   virtual int neighbour(const int vertexIndex, const std::string &direction, const int sign) = 0;
+  // Translate between the dense numbering returned by edgeIndex
+  // and the original seven slot numbering
+  virtual int denseEdgeIndex(const int sparseEdgeIndex) = 0;
+  virtual int denseToSparseEdge(const int edgeIndex) = 0;
   virtual void createFaces() = 0;
   virtual void createVertexToEdges() = 0;
   virtual void createUpEdgesMap() = 0;
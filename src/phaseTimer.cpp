@@ -0,0 +1,153 @@
+#include "phaseTimer.h"
+#include <chrono>
+#include <cstdint>
+#if defined(PHASE_COUNTERS) && defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_COUNTERS
+#endif
+
+const char *phaseNames[numberOfPhases] = {"construction", "correlated indices", "data errors", "measurement errors",
+                                          "syndrome", "sweep", "snapshot", "readout"};
+const char *counterNames[numberOfCounters] = {"cycles", "instructions", "cache misses", "branch misses",
+                                              "page faults"};
+
+static int64_t phaseNanoseconds[numberOfPhases] = {};
+static int64_t phaseCounts[numberOfPhases][numberOfCounters] = {};
+
+#ifdef PERF_COUNTERS
+static int counterFiles[numberOfCounters]; // -1 where the counter could not be opened
+static int64_t lastCounts[numberOfCounters] = {};
+
+// Open every counter for this thread, user space only (allowed up to
+// perf_event_paranoid 2). Each counter is opened on its own, so one the
+// machine lacks (such as hardware counters in most virtual machines) does not
+// take the others with it.
+static bool openCounters()
+{
+  static const uint32_t types[numberOfCounters] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                                   PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+  static const uint64_t configs[numberOfCounters] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                     PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+                                                     PERF_COUNT_SW_PAGE_FAULTS};
+  for (int k = 0; k < numberOfCounters; ++k)
+  {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = types[k];
+    attributes.config = configs[k];
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    counterFiles[k] = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+  }
+  return true;
+}
+
+static void ensureCounters()
+{
+  static const bool opened = openCounters();
+  (void)opened;
+}
+
+// A counter that fails to read is closed and reported unavailable for the
+// rest of the run; it keeps its last count so no phase is charged a jump.
+static void readCounters(int64_t *counts)
+{
+  ensureCounters();
+  for (int k = 0; k < numberOfCounters; ++k)
+  {
+    counts[k] = lastCounts[k];
+    if (counterFiles[k] < 0)
+    {
+      continue;
+    }
+    uint64_t value;
+    if (read(counterFiles[k], &value, sizeof(value)) != sizeof(value))
+    {
+      close(counterFiles[k]);
+      counterFiles[k] = -1;
+      continue;
+    }
+    counts[k] = value;
+  }
+}
+#endif
+
+double phaseSeconds(const phase timedPhase)
+{
+  return phaseNanoseconds[timedPhase] * 1e-9;
+}
+
+bool counterAvailable(const counter event)
+{
+#ifdef PERF_COUNTERS
+  ensureCounters();
+  return counterFiles[event] >= 0;
+#else
+  (void)event;
+  return false;
+#endif
+}
+
+// Events counted in a phase, -1 if the counter is not available
+int64_t phaseCount(const phase timedPhase, const counter event)
+{
+  return counterAvailable(event) ? phaseCounts[timedPhase][event] : -1;
+}
+
+void resetPhaseTimers()
+{
+  for (auto &nanoseconds : phaseNanoseconds)
+  {
+    nanoseconds = 0;
+  }
+  for (auto &counts : phaseCounts)
+  {
+    for (auto &count : counts)
+    {
+      count = 0;
+    }
+  }
+}
+
+#ifdef PHASE_TIMERS
+static int currentPhase = -1; // -1 outside every timed phase
+static std::chrono::steady_clock::time_point phaseStart;
+
+// Charge the time since the last switch to the current phase and start again
+static void switchPhase(const int nextPhase)
+{
+  auto now = std::chrono::steady_clock::now();
+  if (currentPhase >= 0)
+  {
+    phaseNanoseconds[currentPhase] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - phaseStart).count();
+  }
+#ifdef PERF_COUNTERS
+  int64_t counts[numberOfCounters];
+  readCounters(counts);
+  for (int k = 0; k < numberOfCounters; ++k)
+  {
+    if (currentPhase >= 0)
+    {
+      phaseCounts[currentPhase][k] += counts[k] - lastCounts[k];
+    }
+    lastCounts[k] = counts[k];
+  }
+#endif
+  currentPhase = nextPhase;
+  phaseStart = now;
+}
+
+ScopedPhase::ScopedPhase(const phase timedPhase) : outerPhase(currentPhase)
+{
+  switchPhase(timedPhase);
+}
+
+ScopedPhase::~ScopedPhase()
+{
+  switchPhase(outerPhase);
+}
+#endif
@@ -0,0 +1,64 @@
+#ifndef PHASE_TIMER_H
+#define PHASE_TIMER_H
+
+#include <cstdint>
+
+// Wall time spent in each phase of a run. The timers are only compiled in
+// with PHASE_TIMERS defined (cmake -Dtimers=ON), otherwise TIME_PHASE is
+// empty and every phase reads zero. Time is charged exclusively: a phase
+// entered inside another pauses it, so the phases add up.
+// With PHASE_COUNTERS defined as well (cmake -Dcounters=ON) the phases are
+// also charged the Linux perf_event_open counters below, read at every
+// phase change. A counter the kernel or hardware does not provide (or any
+// counter off Linux or without PHASE_COUNTERS) reads -1.
+#if defined(PHASE_COUNTERS) && !defined(PHASE_TIMERS)
+#define PHASE_TIMERS
+#endif
+
+enum phase
+{
+  phaseConstruction,      // Code and lattice tables
+  phaseCorrelatedIndices, // buildCorrelatedIndices
+  phaseDataErrors,
+  phaseMeasErrors,
+  phaseSyndrome,
+  phaseSweep,
+  phaseSnapshot,          // Snapshots and restores between horizons
+  phaseReadout,           // Readout phase bookkeeping (stall detection, logical check)
+  numberOfPhases
+};
+
+enum counter
+{
+  counterCycles,
+  counterInstructions,
+  counterCacheMisses,
+  counterBranchMisses,
+  counterPageFaults,
+  numberOfCounters
+};
+
+extern const char *phaseNames[numberOfPhases];
+extern const char *counterNames[numberOfCounters];
+
+double phaseSeconds(const phase timedPhase);
+int64_t phaseCount(const phase timedPhase, const counter event);
+bool counterAvailable(const counter event);
+void resetPhaseTimers();
+
+#ifdef PHASE_TIMERS
+class ScopedPhase
+{
+private:
+  int outerPhase;
+
+public:
+  explicit ScopedPhase(const phase timedPhase);
+  ~ScopedPhase();
+};
+#define TIME_PHASE(timedPhase) ScopedPhase scopedPhase(timedPhase)
+#else
+#define TIME_PHASE(timedPhase)
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include "batch.h"
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+
+// One seeded configuration of the regression run with its golden success count
+struct regressionCase
+{
+    std::string name;
+    runParameters params; // Sweep limit and timeout of 0 pick the data_generator.py defaults
+    gridRow row;
+    uint64_t seed;
+    int successes = -1;   // Golden count, -1 if none has been recorded
+};
+
+// What one run of a case did, and how it compares with the stored files
+struct regressionOutcome
+{
+    int successes = 0;
+    double trialsPerSecond = 0; // Construction excluded
+    double baseline = 0;        // Stored trials per second, 0 if there is none
+    bool matches = false;       // Successes equal the golden count
+    bool slower = false;        // Throughput more than the tolerance below the baseline
+};
+
+// Rows of a CSV file as maps from column name to field, the header required
+// to name every column in required
+std::vector<std::map<std::string, std::string>> readRecords(std::istream &input, const vstr &required)
+{
+    std::vector<std::map<std::string, std::string>> records;
+    vstr names;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.find_first_not_of(" \t") == std::string::npos)
+        {
+            continue;
+        }
+        vstr fields = splitFields(line, ',');
+        if (line.back() == ',')
+        {
+            fields.push_back(""); // getline drops an empty last field
+        }
+        if (names.empty())
+        {
+            names = fields;
+            for (const auto &name : required)
+            {
+                if (std::find(names.begin(), names.end(), name) == names.end())
+                {
+                    throw std::invalid_argument("Regression file has no " + name + " column.");
+                }
+            }
+            continue;
+        }
+        if (fields.size() != names.size())
+        {
+            throw std::invalid_argument("Regression row has the wrong number of fields: " + line);
+        }
+        std::map<std::string, std::string> record;
+        for (int i = 0; i < static_cast<int>(names.size()); ++i)
+        {
+            record[names[i]] = fields[i];
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+bool readBool(const std::string &field)
+{
+    if (field != "true" && field != "false")
+    {
+        throw std::invalid_argument("Incorrect boolean in regression file: " + field);
+    }
+    return field == "true";
+}
+
+// Golden file: a header, then one case per row. An empty successes field
+// means the count has not been recorded yet.
+std::vector<regressionCase> readRegressionCases(std::istream &input)
+{
+    std::vector<regressionCase> cases;
+    auto records = readRecords(input, {"name", "lattice_type", "L", "p", "q", "cycles", "trials", "sweep_schedule",
+                                       "greedy", "correlated", "seed", "successes"});
+    for (auto &record : records)
+    {
+        regressionCase c;
+        c.name = record["name"];
+        c.params = {0, 0, 0, 0, record["sweep_schedule"], 0, record["lattice_type"],
+                    readBool(record["greedy"]), readBool(record["correlated"]), 1};
+        c.row = {std::stoi(record["L"]), std::stod(record["p"]), std::stod(record["q"]),
+                 std::stoi(record["cycles"]), std::stoi(record["trials"]), static_cast<int>(cases.size())};
+        c.seed = std::stoull(record["seed"]);
+        c.successes = record["successes"].empty() ? -1 : std::stoi(record["successes"]);
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+void writeRegressionCases(std::ostream &output, const std::vector<regressionCase> &cases)
+{
+    output << "name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed,successes" << std::endl;
+    for (const auto &c : cases)
+    {
+        output << std::boolalpha << c.name << "," << c.params.latticeType << "," << c.row.l << "," << c.row.p << ","
+               << c.row.q << "," << c.row.cycles << "," << c.row.trials << "," << c.params.sweepSchedule << ","
+               << c.params.greedy << "," << c.params.correlatedErrors << "," << c.seed << ",";
+        if (c.successes >= 0)
+        {
+            output << c.successes;
+        }
+        output << std::noboolalpha << std::endl;
+    }
+}
+
+// Baseline file: trials per second of each case on the machine that wrote it
+std::map<std::string, double> readBaseline(std::istream &input)
+{
+    std::map<std::string, double> baseline;
+    for (auto &record : readRecords(input, {"name", "trials_per_second"}))
+    {
+        baseline[record["name"]] = std::stod(record["trials_per_second"]);
+    }
+    return baseline;
+}
+
+void writeBaseline(std::ostream &output, const std::map<std::string, double> &baseline)
+{
+    output << "name,trials_per_second" << std::endl;
+    for (const auto &entry : baseline)
+    {
+        output << entry.first << "," << entry.second << std::endl;
+    }
+}
+
+// Run every trial of a case from its seed. Each case builds its own code and
+// reseeds the decoder's random stream, so its trials do not depend on which
+// cases ran before it.
+regressionOutcome runRegressionCase(const regressionCase &c)
+{
+    codeCache cache;
+    rnEngine = pcg32(c.seed);
+    batchResult batch = runGridRow(c.params, c.row, cache);
+    regressionOutcome outcome;
+    outcome.successes = batch.successes;
+    outcome.trialsPerSecond = batch.elapsed > 0 ? batch.trials / batch.elapsed : 0;
+    return outcome;
+}
+
+// Compare an outcome with the golden count and the baseline, where slower
+// means below the baseline by more than tolerance (a fraction of it). With no
+// golden count the successes cannot match; with no baseline nothing is slower.
+void compareOutcome(regressionOutcome &outcome, const regressionCase &c,
+                    const std::map<std::string, double> &baseline, const double tolerance)
+{
+    outcome.matches = c.successes >= 0 && outcome.successes == c.successes;
+    auto it = baseline.find(c.name);
+    outcome.baseline = it == baseline.end() ? 0 : it->second;
+    outcome.slower = outcome.baseline > 0 && outcome.trialsPerSecond < (1 - tolerance) * outcome.baseline;
+}
+
+#endif
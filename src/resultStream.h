@@ -0,0 +1,115 @@
+#ifndef RESULT_STREAM_H
+#define RESULT_STREAM_H
+
+#include "decoder.h"
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+// Append-only file of length prefixed records, read back by read_results.py.
+// Each record is a little endian uint32 payload length, a one byte type and
+// the payload:
+//     'M' magic text, written once when the file is created
+//     'H' JSON object with the settings of a row, starting the row
+//     'T' packed trials of the current row, 13 bytes each: flags (bit 0
+//         success, bit 1 clean syndrome, bit 2 stalled), int32 readout
+//         sweeps, int32 abort round, float32 seconds
+//     'E' JSON object with the outcome of the row, ending it
+// A row without its 'E' record was interrupted and can be dropped.
+class ResultStream
+{
+private:
+  std::ofstream output;
+  std::string trials; // Packed trials not yet written
+  static const int trialSize = 13;
+  static const int trialsPerRecord = 4096;
+
+  static void putUint32(std::string &buffer, const uint32_t value)
+  {
+    for (int i = 0; i < 4; ++i)
+    {
+      buffer += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+  }
+
+  void writeRecord(const char type, const std::string &payload)
+  {
+    std::string prefix;
+    putUint32(prefix, payload.size());
+    prefix += type;
+    output.write(prefix.data(), prefix.size());
+    output.write(payload.data(), payload.size());
+  }
+
+public:
+  // Given a length, the file is first cut back to it, dropping what a run
+  // wrote after its last checkpoint
+  explicit ResultStream(const std::string &path, const long long length = -1)
+  {
+    if (length >= 0 && truncate(path.c_str(), length) != 0)
+    {
+      throw std::invalid_argument("Cannot cut result stream " + path + " back to its checkpoint.");
+    }
+    output.open(path, std::ios::binary | std::ios::app);
+    if (!output)
+    {
+      throw std::invalid_argument("Cannot open result stream " + path + ".");
+    }
+    output.seekp(0, std::ios::end);
+    if (output.tellp() == 0)
+    {
+      writeRecord('M', "SweepResults 1");
+    }
+  }
+
+  ~ResultStream()
+  {
+    flushTrials();
+  }
+
+  void beginRow(const std::string &settings)
+  {
+    writeRecord('H', settings);
+  }
+
+  void addTrial(const runResult &result, const double seconds)
+  {
+    trials += static_cast<char>(result.success | (result.cleanSyndrome << 1) | (result.stalled << 2));
+    putUint32(trials, static_cast<uint32_t>(result.readoutSweeps));
+    putUint32(trials, static_cast<uint32_t>(result.abortRound));
+    float time = seconds;
+    uint32_t timeBits;
+    std::memcpy(&timeBits, &time, sizeof(timeBits));
+    putUint32(trials, timeBits);
+    if (static_cast<int>(trials.size()) == trialSize * trialsPerRecord)
+    {
+      flushTrials();
+    }
+  }
+
+  void flushTrials()
+  {
+    if (!trials.empty())
+    {
+      writeRecord('T', trials);
+      trials.clear();
+    }
+  }
+
+  // Bytes in the file once every pending trial is written
+  uint64_t length()
+  {
+    flushTrials();
+    output.flush();
+    return output.tellp();
+  }
+
+  void endRow(const std::string &outcome)
+  {
+    flushTrials();
+    writeRecord('E', outcome);
+    output.flush();
+  }
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "code.h"
 #include "rhombicCode.h"
+#include "phaseTimer.h"
 #include "rhombicToricLattice.h"
 #include "rhombicLattice.h"
 #include <string>
@@ -22,16 +23,24 @@ RhombicCode::RhombicCode(const int l, const double p, const double q, bool bound
         latticeParity = 0;
         lattice = std::make_unique<RhombicToricLattice>(l);
     }
-    numberOfEdges = 2 * 7 * pow(l, 3);
+    numberOfEdges = 4 * pow(l, 3);
     buildSweepIndices();
     syndrome.assign(numberOfEdges, 0);
-    flipBits.assign(numberOfFaces, 0);
+    error.resize(numberOfFaces);
+    flipBits.resize(numberOfFaces);
+    flippedFaces.reserve(numberOfFaces);
     lattice->createFaces();
     lattice->createUpEdgesMap();
     lattice->createVertexToEdges();
     upEdgesMap = lattice->getUpEdgesMap();
     faceToEdges = lattice->getFaceToEdges(); 
     vertexToEdges = lattice->getVertexToEdges();
+    buildStabiliserTables();
+    buildUpEdgeTables();
+    buildDirectionToEdge({"xyz", "xy", "yz", "xz", "-yz", "-xz", "-xy", "-xyz"});
+    buildDirectionPairToFace();
+    buildVertexTypes();
+    partitionSweepIndices();
     buildLogicals();
 }
 
@@ -130,10 +139,89 @@ void RhombicCode::buildSweepIndices()
     }
 }
 
+void RhombicCode::buildVertexTypes()
+{
+    vertexTypes.assign(2 * pow(l, 3), absentVertex);
+    for (int i = 0; i < 2 * pow(l, 3); ++i)
+    {
+        const cartesian4 coordinate = lattice->indexToCoordinate(i);
+        if (coordinate.w == 1)
+        {
+            vertexTypes[i] = halfVertex;
+        }
+        else if ((coordinate.x + coordinate.y + coordinate.z) % 2 == latticeParity)
+        {
+            vertexTypes[i] = fullVertex;
+        }
+    }
+}
+
+void RhombicCode::partitionSweepIndices()
+{
+    bulkSweepIndices.clear();
+    boundarySweepIndices.clear();
+    boundaryShell.assign(vertexTypes.size(), 0);
+    for (const int vertexIndex : sweepIndices)
+    {
+        const VertexType vertexType = vertexTypes[vertexIndex];
+        if (vertexType == absentVertex)
+        {
+            // Never has up-edges
+            continue;
+        }
+        bool bulk = true;
+        if (boundaries)
+        {
+            // Full vertices only need special cases on z = 1 and z = l - 1
+            // and half vertices on y = 0 and y = l - 2
+            const cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
+            if (vertexType == fullVertex)
+            {
+                bulk = coordinate.z != 1 && coordinate.z != l - 1;
+            }
+            else
+            {
+                bulk = coordinate.y != 0 && coordinate.y != l - 2;
+            }
+        }
+        if (bulk)
+        {
+            bulkSweepIndices.push_back(vertexIndex);
+        }
+        else
+        {
+            boundarySweepIndices.push_back(vertexIndex);
+            boundaryShell[vertexIndex] = 1;
+        }
+    }
+}
+
+void RhombicCode::setTileSize(const int size)
+{
+    if (size < 0)
+    {
+        throw std::invalid_argument("Tile size cannot be negative.");
+    }
+    tileSize = size;
+    tileIndices(bulkSweepIndices);
+    tileIndices(boundarySweepIndices);
+}
+
+vint &RhombicCode::getBulkSweepIndices()
+{
+    return bulkSweepIndices;
+}
+
+vint &RhombicCode::getBoundarySweepIndices()
+{
+    return boundarySweepIndices;
+}
+
 void RhombicCode::sweep(const std::string &direction, bool greedy)
 {
-    clearFlipBits();
-    vstr edgeDirections;
+    TIME_PHASE(phaseSweep);
+    clearFlippedFaces();
+    astr3 edgeDirections;
     if (direction == "xyz")
     {
         edgeDirections = {"xy", "yz", "xz"};
@@ -170,213 +258,83 @@ void RhombicCode::sweep(const std::string &direction, bool greedy)
     {
         throw std::invalid_argument("Invalid sweep direction.");
     }
-    // for (int vertexIndex = 0; vertexIndex < 2 * pow(l, 3); ++vertexIndex)
-    for (auto const vertexIndex : sweepIndices)
+    const int *upEdgeTable = upEdgeTables[direction].data();
+    if (inPlace)
     {
-        if (!greedy)
+        // Later vertices see the syndrome left by earlier flips
+        for (auto const vertexIndex : inPlaceOrder(direction))
         {
-            if (!checkExtremalVertex(vertexIndex, direction))
-            {
-                continue;
-            }
+            sweepVertex(vertexIndex, direction, edgeDirections, upEdgeTable + 4 * vertexIndex, greedy, !boundaryShell[vertexIndex]);
         }
-        // std::cout << "Trying to find sweep edges... ";
-        vstr sweepEdges = findSweepEdges(vertexIndex, direction);
-        // if (sweepEdges.size() > 0)
-        // {
-        //     std::cerr << "Vertex = " << lattice->indexToCoordinate(vertexIndex) << std::endl;
-        //     for (auto &e : sweepEdges)
-        //     {
-        //         std::cerr << e << std::endl;
-        //     }
-        // }
-        // std::cout << "FOUND." << std::endl;
-        if (sweepEdges.size() > 4)
+    }
+    else
+    {
+        for (auto const vertexIndex : bulkSweepIndices)
         {
-            throw std::length_error("More than four up-edges found for a rhombic lattice vertex.");
+            sweepVertex(vertexIndex, direction, edgeDirections, upEdgeTable + 4 * vertexIndex, greedy, true);
         }
-        if (sweepEdges.size() == 0)
+        for (auto const vertexIndex : boundarySweepIndices)
         {
-            continue;
+            sweepVertex(vertexIndex, direction, edgeDirections, upEdgeTable + 4 * vertexIndex, greedy, false);
         }
-        cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
-        // if (sweepEdges.size() == 1 && (!boundaries || coordinate.w == 0))
-        if (sweepEdges.size() == 1 && !boundaries)
+    }
+    applyFlips();
+}
+
+void RhombicCode::sweepVertex(const int vertexIndex, const std::string &direction, const astr3 &edgeDirections, const int *upEdges, bool greedy, bool bulk)
+{
+    if (!greedy)
+    {
+        if (!checkExtremalVertex(vertexIndex, upEdges))
         {
-            continue;
+            return;
         }
-        if (coordinate.w == 0)
+    }
+    svstr sweepEdges = findSweepEdges(vertexIndex, upEdges);
+    if (bulk)
+    {
+        // Bulk vertices follow the toric rules
+        if (sweepEdges.size() < 2)
         {
-            if ((coordinate.x + coordinate.y + coordinate.z) % 2 == latticeParity)
-            {
-                if (boundaries)
-                {
-                    sweepFullVertexBoundary(vertexIndex, sweepEdges, direction, edgeDirections);
-                }
-                else
-                {
-                    sweepFullVertex(vertexIndex, sweepEdges, direction, edgeDirections);
-                }
-            }
-            else
-            {
-                throw std::invalid_argument("Vertex not present in lattice has up-edges.");
-            }
+            return;
+        }
+        if (vertexTypes[vertexIndex] == fullVertex)
+        {
+            sweepFullVertex(vertexIndex, sweepEdges, direction, edgeDirections);
         }
         else
         {
-            if (boundaries)
-            {
-                sweepHalfVertexBoundary(vertexIndex, sweepEdges, direction, edgeDirections);
-            }
-            else
-            {
-                sweepHalfVertex(vertexIndex, sweepEdges, direction, edgeDirections);
-            }
+            sweepHalfVertex(vertexIndex, sweepEdges, direction, edgeDirections);
         }
     }
-    for (int i = 0, imax = flipBits.size(); i < imax; ++i)
+    else
     {
-        if (flipBits[i])
+        // Boundary shell, where single up-edges can also be swept
+        if (sweepEdges.size() == 0)
         {
-            auto it = error.find(i);
-            if (it != error.end())
-            {
-                error.erase(it);
-            }
-            else
-            {
-                error.insert(i);
-            }
-            if (sweepRate > 1)
-            {
-                for (const int edge : faceToEdges[i])
-                {
-                    // std::cerr << edge << std::endl;
-                    if (boundaries)
-                    {
-                        auto it2 = syndromeIndices.find(edge);
-                        if (it2 == syndromeIndices.end())
-                        {
-                            continue;
-                        }
-                    }
-                    syndrome[edge] = (syndrome[edge] + 1) % 2;
-                }
-            }
+            return;
+        }
+        if (vertexTypes[vertexIndex] == fullVertex)
+        {
+            sweepFullVertexBoundary(vertexIndex, sweepEdges, direction, edgeDirections);
+        }
+        else
+        {
+            sweepHalfVertexBoundary(vertexIndex, sweepEdges, direction, edgeDirections);
         }
     }
 }
 
-vstr RhombicCode::findSweepEdges(const int vertexIndex, const std::string &direction)
+void RhombicCode::flipSpannedFace(const int vertexIndex, const std::string &direction0, const std::string &direction1)
 {
-    vstr sweepEdges;
-    auto &upEdges = upEdgesMap[direction][vertexIndex];
-    for (const int edge : upEdges)
+    const int faceIndex = spannedFace(vertexIndex, direction0, direction1);
+    if (faceIndex != -1)
     {
-        if (syndrome[edge] == 1)
-        {
-            int xyzEdge = -1, xyEdge = -1, xzEdge = -1, yzEdge = -1;
-            int minusXYZEdge = -1, minusXYEdge = -1, minusXZEdge = -1, minusYZEdge = -1;
-            try
-            {
-                xyzEdge = lattice->edgeIndex(vertexIndex, "xyz", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                xyEdge = lattice->edgeIndex(vertexIndex, "xy", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                xzEdge = lattice->edgeIndex(vertexIndex, "xz", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                yzEdge = lattice->edgeIndex(vertexIndex, "yz", 1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusXYZEdge = lattice->edgeIndex(vertexIndex, "xyz", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusXYEdge = lattice->edgeIndex(vertexIndex, "xy", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusXZEdge = lattice->edgeIndex(vertexIndex, "xz", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-            try
-            {
-                minusYZEdge = lattice->edgeIndex(vertexIndex, "yz", -1);
-            }
-            catch (const std::invalid_argument &e)
-            {
-            }
-
-            if (xyzEdge == edge)
-            {
-                sweepEdges.push_back("xyz");
-            }
-            else if (xyEdge == edge)
-            {
-                sweepEdges.push_back("xy");
-            }
-            else if (yzEdge == edge)
-            {
-                sweepEdges.push_back("yz");
-            }
-            else if (xzEdge == edge)
-            {
-                sweepEdges.push_back("xz");
-            }
-            else if (minusYZEdge == edge)
-            {
-                sweepEdges.push_back("-yz");
-            }
-            else if (minusXZEdge == edge)
-            {
-                sweepEdges.push_back("-xz");
-            }
-            else if (minusXYEdge == edge)
-            {
-                sweepEdges.push_back("-xy");
-            }
-            else if (minusXYZEdge == edge)
-            {
-                sweepEdges.push_back("-xyz");
-            }
-            else
-            {
-                throw std::invalid_argument("Edge index does not correspond to a valid edge.");
-            }
-        }
+        flipFace(faceIndex);
     }
-    return sweepEdges;
 }
 
-void RhombicCode::sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void RhombicCode::sweepFullVertex(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     // std::cout << "Sweep of coordinate = " << lattice->indexToCoordinate(vertexIndex) << " ... ";
     auto &edge0 = upEdgeDirections[0];
@@ -386,33 +344,9 @@ void RhombicCode::sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const
     auto sweepDirectionIndex = std::distance(sweepEdges.begin(), std::find(sweepEdges.begin(), sweepEdges.end(), sweepDirection));
     if (sweepEdges.size() == 4)
     {
-        try
-        {
-            vint vertices = faceVertices(vertexIndex, {sweepDirection, edge0, edge0});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
-        try
-        {
-            vint vertices = faceVertices(vertexIndex, {sweepDirection, edge1, edge1});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
-        try
-        {
-            vint vertices = faceVertices(vertexIndex, {sweepDirection, edge2, edge2});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
+        flipSpannedFace(vertexIndex, sweepDirection, edge0);
+        flipSpannedFace(vertexIndex, sweepDirection, edge1);
+        flipSpannedFace(vertexIndex, sweepDirection, edge2);
     }
     else if (sweepDirectionIndex < sweepEdges.size())
     {
@@ -425,39 +359,15 @@ void RhombicCode::sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const
         }
         if (sweepEdges[0] == edge0)
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge0, edge0});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge0);
         }
         else if (sweepEdges[0] == edge2)
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge2, edge2});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge2);
         }
         else if (sweepEdges[0] == edge1)
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge1, edge1});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge1);
         }
         else
         {
@@ -475,68 +385,20 @@ void RhombicCode::sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const
         if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge2) ||
             (sweepEdges[0] == edge2 && sweepEdges[1] == edge0))
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge0, edge0});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge2, edge2});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge0);
+            flipSpannedFace(vertexIndex, sweepDirection, edge2);
         }
         else if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge1) ||
                  (sweepEdges[0] == edge1 && sweepEdges[1] == edge0))
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge0, edge0});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge1, edge1});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge0);
+            flipSpannedFace(vertexIndex, sweepDirection, edge1);
         }
         else if ((sweepEdges[0] == edge1 && sweepEdges[1] == edge2) ||
                  (sweepEdges[0] == edge2 && sweepEdges[1] == edge1))
         {
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge1, edge1});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
-            try
-            {
-                vint vertices = faceVertices(vertexIndex, {sweepDirection, edge2, edge2});
-                localFlip(vertices);
-            }
-            catch (const std::invalid_argument &e)
-            {
-                // std::cerr << "WARNING: " << e.what() << std::endl;
-            }
+            flipSpannedFace(vertexIndex, sweepDirection, edge1);
+            flipSpannedFace(vertexIndex, sweepDirection, edge2);
         }
         else
         {
@@ -546,7 +408,7 @@ void RhombicCode::sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const
     // std::cout << "Successful." << std::endl;
 }
 
-void RhombicCode::sweepHalfVertex(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void RhombicCode::sweepHalfVertex(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     // std::cout << "Sweep of coordinate = " << lattice->indexToCoordinate(vertexIndex) << " ... ";
     auto &edge0 = upEdgeDirections[0];
@@ -561,44 +423,17 @@ void RhombicCode::sweepHalfVertex(const int vertexIndex, vstr &sweepEdges, const
     if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge2) ||
         (sweepEdges[0] == edge2 && sweepEdges[1] == edge0))
     {
-        vint vertices;
-        try
-        {
-            vertices = faceVertices(vertexIndex, {edge0, edge2, edge2});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
+        flipSpannedFace(vertexIndex, edge0, edge2);
     }
     else if ((sweepEdges[0] == edge0 && sweepEdges[1] == edge1) ||
              (sweepEdges[0] == edge1 && sweepEdges[1] == edge0))
     {
-        vint vertices;
-        try
-        {
-            vertices = faceVertices(vertexIndex, {edge0, edge1, edge1});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
+        flipSpannedFace(vertexIndex, edge0, edge1);
     }
     else if ((sweepEdges[0] == edge1 && sweepEdges[1] == edge2) ||
              (sweepEdges[0] == edge2 && sweepEdges[1] == edge1))
     {
-        vint vertices;
-        try
-        {
-            vertices = faceVertices(vertexIndex, {edge2, edge1, edge1});
-            localFlip(vertices);
-        }
-        catch (const std::invalid_argument &e)
-        {
-            // std::cerr << "WARNING: " << e.what() << std::endl;
-        }
+        flipSpannedFace(vertexIndex, edge2, edge1);
     }
     else
     {
@@ -607,21 +442,21 @@ void RhombicCode::sweepHalfVertex(const int vertexIndex, vstr &sweepEdges, const
     // std::cout << "Successful." << std::endl;
 }
 
-void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     // Only sweep one edge faces 
     cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
     bool sweepComplete = false;
     if (sweepEdges.size() == 1)
     {
-        vint vertices;
+        aint4 vertices;
         if (coordinate.y == 0 && coordinate.x == l - 2)
         {
             if (sweepEdges[0] == "xy")
             {
                 if (sweepDirection == "-yz" || sweepDirection == "-xz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xy", "-xyz", "-xyz"});
+                    vertices = faceVertices(vertexIndex, "xy", "-xyz");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -630,7 +465,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xz" || sweepDirection == "yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xyz", "-xy", "-xy"});
+                    vertices = faceVertices(vertexIndex, "xyz", "-xy");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -642,7 +477,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xy" || sweepDirection == "-xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xz", "-yz", "-yz"});
+                    vertices = faceVertices(vertexIndex, "-xz", "-yz");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -652,7 +487,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xy" || sweepDirection == "xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"yz", "xz", "xz"});
+                    vertices = faceVertices(vertexIndex, "yz", "xz");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -664,7 +499,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xz" || sweepDirection == "-yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xyz", "xy", "xy"});
+                    vertices = faceVertices(vertexIndex, "-xyz", "xy");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -673,7 +508,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xz" || sweepDirection == "yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xyz", "-xy", "-xy"});
+                    vertices = faceVertices(vertexIndex, "xyz", "-xy");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -685,7 +520,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xy" || sweepDirection == "-xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xz", "-yz", "-yz"});
+                    vertices = faceVertices(vertexIndex, "-xz", "-yz");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -694,7 +529,7 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xy" || sweepDirection == "xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xz", "yz", "yz"});
+                    vertices = faceVertices(vertexIndex, "xz", "yz");
                     localFlip(vertices);
                 }
                 sweepComplete = true;
@@ -708,27 +543,27 @@ void RhombicCode::sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdge
     }
 }
 
-void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     // Makes the rule non-deterministic for perfect measurements 
     cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
     if (sweepEdges.size() == 1)
     {
-        vint vertices;
+        aint4 vertices;
         if (coordinate.y == 0)
         {
             if (sweepEdges[0] == "xy")
             {
                 if (sweepDirection == "-xz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xy", "-xyz", "-xyz"});
+                    vertices = faceVertices(vertexIndex, "xy", "-xyz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "xyz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xy", "xz", "xz"});
+                        vertices = faceVertices(vertexIndex, "xy", "xz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -739,10 +574,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "-yz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"-xyz", "xz"};
+                    const char *dirs[] = {"-xyz", "xz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xy", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "xy", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -755,14 +590,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"yz", "xz", "xz"});
+                    vertices = faceVertices(vertexIndex, "yz", "xz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "-xz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"yz", "-xyz", "-xyz"});
+                        vertices = faceVertices(vertexIndex, "yz", "-xyz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -773,10 +608,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "-xy")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"-xyz", "xz"};
+                    const char *dirs[] = {"-xyz", "xz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"yz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "yz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -789,14 +624,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "xy")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xz", "-yz", "-yz"});
+                    vertices = faceVertices(vertexIndex, "-xz", "-yz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "yz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xz", "-xy", "-xy"});
+                        vertices = faceVertices(vertexIndex, "-xz", "-xy");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -807,10 +642,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "-xyz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"-xy", "-yz"};
+                    const char *dirs[] = {"-xy", "-yz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "-xz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -823,14 +658,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xyz", "-xy", "-xy"});
+                    vertices = faceVertices(vertexIndex, "xyz", "-xy");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "xy")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xyz", "-yz", "-yz"});
+                        vertices = faceVertices(vertexIndex, "xyz", "-yz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -841,10 +676,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "xz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"-xy", "-yz"};
+                    const char *dirs[] = {"-xy", "-yz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xyz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "xyz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -860,14 +695,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "-yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xyz", "xy", "xy"});
+                    vertices = faceVertices(vertexIndex, "-xyz", "xy");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "-xy")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xyz", "yz", "yz"});
+                        vertices = faceVertices(vertexIndex, "-xyz", "yz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -878,10 +713,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "-xz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"xy", "yz"};
+                    const char *dirs[] = {"xy", "yz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xyz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "-xyz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -894,14 +729,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "-xy")
                 {
-                    vertices = faceVertices(vertexIndex, {"xz", "yz", "yz"});
+                    vertices = faceVertices(vertexIndex, "xz", "yz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "-yz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xz", "xy", "xy"});
+                        vertices = faceVertices(vertexIndex, "xz", "xy");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -912,10 +747,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "xyz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"xy", "yz"};
+                    const char *dirs[] = {"xy", "yz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"xz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "xz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -928,14 +763,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "-xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-yz", "-xz", "-xz"});
+                    vertices = faceVertices(vertexIndex, "-yz", "-xz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "xz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-yz", "xyz", "xyz"});
+                        vertices = faceVertices(vertexIndex, "-yz", "xyz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -946,10 +781,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "xy")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"xyz", "-xz"};
+                    const char *dirs[] = {"xyz", "-xz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-yz", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "-yz", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -962,14 +797,14 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
             {
                 if (sweepDirection == "xz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xy", "xyz", "xyz"});
+                    vertices = faceVertices(vertexIndex, "-xy", "xyz");
                     localFlip(vertices);
                 }
                 else if (sweepDirection == "-xyz")
                 {
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xy", "-xz", "-xz"});
+                        vertices = faceVertices(vertexIndex, "-xy", "-xz");
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -980,10 +815,10 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
                 else if (sweepDirection == "yz")
                 {
                     int index = distInt0To1(rnEngine);
-                    vstr dirs = {"xyz", "-xz"};
+                    const char *dirs[] = {"xyz", "-xz"};
                     try
                     {
-                        vertices = faceVertices(vertexIndex, {"-xy", dirs[index], dirs[index]});
+                        vertices = faceVertices(vertexIndex, "-xy", dirs[index]);
                         localFlip(vertices);
                     }
                     catch (const std::invalid_argument &e)
@@ -1000,20 +835,20 @@ void RhombicCode::sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweep
     }
 }
 
-void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections)
+void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections)
 {
     // Sweep all awkward faces on z=1 and z=l-1 boundaries
     cartesian4 coordinate = lattice->indexToCoordinate(vertexIndex);
     if (sweepEdges.size() == 1)
     {
-        vint vertices;
+        aint4 vertices;
         if (coordinate.z == 1) 
         {
             if (sweepEdges[0] == "xz")
             {
                 if (sweepDirection == "-yz" || sweepDirection == "xz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xz", "-yz", "-yz"});
+                    vertices = faceVertices(vertexIndex, "xz", "-yz");
                     localFlip(vertices);
                 }
             }
@@ -1021,7 +856,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xy" || sweepDirection == "-xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xyz", "-xy", "-xy"});
+                    vertices = faceVertices(vertexIndex, "-xyz", "-xy");
                     localFlip(vertices);
                 }
             }
@@ -1029,7 +864,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xz" || sweepDirection == "yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xz", "yz", "yz"});
+                    vertices = faceVertices(vertexIndex, "-xz", "yz");
                     localFlip(vertices);
                 }
             }
@@ -1037,7 +872,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xy" || sweepDirection == "xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xyz", "xy", "xy"});
+                    vertices = faceVertices(vertexIndex, "xyz", "xy");
                     localFlip(vertices);
                 }
             }
@@ -1048,7 +883,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-yz" || sweepDirection == "xz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xz", "-yz", "-yz"});
+                    vertices = faceVertices(vertexIndex, "xz", "-yz");
                     localFlip(vertices);
                 }
             }
@@ -1056,7 +891,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xy" || sweepDirection == "-xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xyz", "-xy", "-xy"});
+                    vertices = faceVertices(vertexIndex, "-xyz", "-xy");
                     localFlip(vertices);
                 }
             }
@@ -1064,7 +899,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "-xz" || sweepDirection == "yz")
                 {
-                    vertices = faceVertices(vertexIndex, {"-xz", "yz", "yz"});
+                    vertices = faceVertices(vertexIndex, "-xz", "yz");
                     localFlip(vertices);
                 }
             }
@@ -1072,7 +907,7 @@ void RhombicCode::sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdge
             {
                 if (sweepDirection == "xy" || sweepDirection == "xyz")
                 {
-                    vertices = faceVertices(vertexIndex, {"xyz", "xy", "xy"});
+                    vertices = faceVertices(vertexIndex, "xyz", "xy");
                     localFlip(vertices);
                 }
             }
@@ -1168,4 +1003,5 @@ void RhombicCode::buildLogicals()
             logicalZ3.push_back(lattice->findFace(faceVertices));
         }
     }
+    buildLogicalMembership();
 }
\ No newline at end of file
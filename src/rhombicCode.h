@@ -8,21 +8,41 @@ class RhombicCode : public Code
 {
 private:
   int latticeParity;
+  // Vertex classes looked up by the sweep instead of recomputing coordinates
+  enum VertexType : int8_t
+  {
+    absentVertex,
+    fullVertex,
+    halfVertex
+  };
+  std::vector<VertexType> vertexTypes;
+  // Vertices that follow the toric rules and the boundary shell that needs special cases
+  vint bulkSweepIndices;
+  vint boundarySweepIndices;
+  std::vector<int8_t> boundaryShell;
+
+  // Bulk sweeps look the face up instead of searching for it with faceVertices
+  void flipSpannedFace(const int vertexIndex, const std::string &direction0, const std::string &direction1);
 
 public:
   RhombicCode(const int latticeLength, const double dataErrorProbability, const double measErrorProbability, bool boundaries, const int sweepRate);
 
   void buildSyndromeIndices();
   void buildSweepIndices();
+  void buildVertexTypes();
+  void partitionSweepIndices();
+  void setTileSize(const int tileSize);
   void sweep(const std::string &direction, bool greedy);
-  vstr findSweepEdges(const int vertexIndex, const std::string &direction);
+  void sweepVertex(const int vertexIndex, const std::string &direction, const astr3 &edgeDirections, const int *upEdges, bool greedy, bool bulk);
   void buildLogicals();
+  vint &getBulkSweepIndices();
+  vint &getBoundarySweepIndices();
 
-  void sweepFullVertex(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
-  void sweepHalfVertex(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
-  void sweepFullVertexBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
-  void sweepHalfVertexBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
-  void sweepHalfVertexBulkBoundary(const int vertexIndex, vstr &sweepEdges, const std::string &sweepDirection, const vstr &upEdgeDirections);
+  void sweepFullVertex(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
+  void sweepHalfVertex(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
+  void sweepFullVertexBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
+  void sweepHalfVertexBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
+  void sweepHalfVertexBulkBoundary(const int vertexIndex, svstr &sweepEdges, const std::string &sweepDirection, const astr3 &upEdgeDirections);
 };
 
 #endif
\ No newline at end of file
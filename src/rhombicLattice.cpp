@@ -123,6 +123,16 @@ int RhombicLattice::neighbour(const int vertexIndex, const std::string &directio
     }
 }
 
+int RhombicLattice::denseEdgeIndex(const int sparseEdgeIndex)
+{
+    return rhombicDenseEdgeIndex(sparseEdgeIndex, 1);
+}
+
+int RhombicLattice::denseToSparseEdge(const int edgeIndex)
+{
+    return rhombicDenseToSparseEdge(edgeIndex, 1);
+}
+
 void RhombicLattice::createFaces()
 {
     int faceIndex = 0;
@@ -13,6 +13,8 @@ class RhombicLattice : public Lattice
   public:
     RhombicLattice(const int l);
     int neighbour(const int vertexIndex, const std::string &direction, const int sign);
+    int denseEdgeIndex(const int sparseEdgeIndex);
+    int denseToSparseEdge(const int edgeIndex);
     void createFaces();
     void createVertexToEdges();
     void createUpEdgesMap();
@@ -105,6 +105,16 @@ int RhombicToricLattice::neighbour(const int vertexIndex, const std::string &dir
     return coordinateToIndex(coordinate);
 }
 
+int RhombicToricLattice::denseEdgeIndex(const int sparseEdgeIndex)
+{
+    return rhombicDenseEdgeIndex(sparseEdgeIndex, 0);
+}
+
+int RhombicToricLattice::denseToSparseEdge(const int edgeIndex)
+{
+    return rhombicDenseToSparseEdge(edgeIndex, 0);
+}
+
 void RhombicToricLattice::createFaces()
 {
     int faceIndex = 0;
@@ -14,6 +14,8 @@ class RhombicToricLattice : public Lattice
     RhombicToricLattice(const int l);
     RhombicToricLattice();
     int neighbour(const int vertexIndex, const std::string &direction, const int sign);
+    int denseEdgeIndex(const int sparseEdgeIndex);
+    int denseToSparseEdge(const int edgeIndex);
     void createFaces();
     void createVertexToEdges();
     void createUpEdgesMap();
@@ -0,0 +1,105 @@
+#include "roundRecorder.h"
+#include <algorithm>
+#include <stdexcept>
+
+const char *sweepDirectionNames[8] = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"};
+
+static int8_t directionIndex(const std::string &direction)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        if (direction == sweepDirectionNames[i])
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+RoundRecorder::RoundRecorder(const int capacity)
+{
+    if (capacity <= 0)
+    {
+        throw std::invalid_argument("Recorder capacity must be positive.");
+    }
+    records.resize(capacity);
+}
+
+void RoundRecorder::add(const roundRecord &record)
+{
+    records[recorded % records.size()] = record;
+    ++recorded;
+}
+
+// Start a trial, or carry one on from an active round
+void RoundRecorder::beginTrial(const int firstRound)
+{
+    ++trial;
+    nextRound = firstRound;
+}
+
+void RoundRecorder::recordActive(const std::string &direction, const int errorWeight, const int syndromeWeight,
+                                 const int facesFlipped)
+{
+    add({trial, nextRound++, 0, directionIndex(direction), errorWeight, syndromeWeight, facesFlipped});
+}
+
+void RoundRecorder::recordReadout(const int sweep, const std::string &direction, const int errorWeight,
+                                  const int syndromeWeight, const int facesFlipped)
+{
+    add({trial, sweep, 1, directionIndex(direction), errorWeight, syndromeWeight, facesFlipped});
+}
+
+int RoundRecorder::size()
+{
+    return std::min<long long>(recorded, records.size());
+}
+
+// Records overwritten because the buffer was full
+long long RoundRecorder::dropped()
+{
+    return recorded - size();
+}
+
+const roundRecord &RoundRecorder::operator[](const int i)
+{
+    return records[(dropped() + i) % records.size()];
+}
+
+void RoundRecorder::writeCsv(std::ostream &output)
+{
+    output << "trial,phase,round,direction,error_weight,syndrome_weight,faces_flipped\n";
+    for (int i = 0; i < size(); ++i)
+    {
+        const roundRecord &record = (*this)[i];
+        output << record.trial << "," << (record.readout ? "readout" : "active") << "," << record.round << ","
+               << (record.direction < 0 ? "" : sweepDirectionNames[record.direction]) << "," << record.errorWeight
+               << "," << record.syndromeWeight << "," << record.facesFlipped << "\n";
+    }
+}
+
+// 22 bytes per record, oldest first: int32 trial, int32 round, int8 readout,
+// int8 direction, int32 error weight, int32 syndrome weight, int32 faces
+// flipped, all little endian
+void RoundRecorder::writeBinary(std::ostream &output)
+{
+    std::string buffer;
+    auto put = [&buffer](const uint32_t value, const int bytes) {
+        for (int i = 0; i < bytes; ++i)
+        {
+            buffer += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    };
+    for (int i = 0; i < size(); ++i)
+    {
+        const roundRecord &record = (*this)[i];
+        put(record.trial, 4);
+        put(record.round, 4);
+        put(static_cast<uint8_t>(record.readout), 1);
+        put(static_cast<uint8_t>(record.direction), 1);
+        put(record.errorWeight, 4);
+        put(record.syndromeWeight, 4);
+        put(record.facesFlipped, 4);
+    }
+    output.write(buffer.data(), buffer.size());
+}
@@ -0,0 +1,51 @@
+#ifndef ROUND_RECORDER_H
+#define ROUND_RECORDER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// State of a trial after one active round or one readout sweep
+struct roundRecord
+{
+  int32_t trial;          // Counted from 0 by beginTrial
+  int32_t round;          // Active round, or readout sweep counted from 1
+  int8_t readout;         // 1 in the readout phase
+  int8_t direction;       // Index into sweepDirectionNames, -1 for none
+  int32_t errorWeight;    // Error faces after the sweeps
+  int32_t syndromeWeight; // Active phase: syndrome the sweeps acted on; readout: syndrome they left
+  int32_t facesFlipped;   // Faces the sweeps of the round flipped
+};
+
+extern const char *sweepDirectionNames[8];
+
+// Keeps the last capacity records of the trials run with it in a buffer
+// allocated up front, so recording never allocates. The run functions of
+// decoder.h take an optional recorder and skip every recording step without
+// one.
+class RoundRecorder
+{
+private:
+  std::vector<roundRecord> records;
+  long long recorded = 0; // Records ever made, the oldest are overwritten
+  int trial = -1;
+  int nextRound = 0;
+
+  void add(const roundRecord &record);
+
+public:
+  explicit RoundRecorder(const int capacity);
+  void beginTrial(const int firstRound = 0);
+  void recordActive(const std::string &direction, const int errorWeight, const int syndromeWeight,
+                    const int facesFlipped);
+  void recordReadout(const int sweep, const std::string &direction, const int errorWeight,
+                     const int syndromeWeight, const int facesFlipped);
+  int size();
+  long long dropped();
+  const roundRecord &operator[](const int i); // From the oldest kept
+  void writeCsv(std::ostream &output);
+  void writeBinary(std::ostream &output);
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef SPLITTING_H
+#define SPLITTING_H
+
+#include "decoder.h"
+#include "statistics.h"
+#include <cmath>
+#include <numeric>
+
+// Logical failure rate estimated by multilevel splitting
+struct splittingResult
+{
+    double failureRate = 0;     // Mean over replicates
+    double standardError = 0;   // Of the mean, from the spread between replicates
+    double lower = 0;           // 95% Student t interval, replicates - 1 degrees of freedom
+    double upper = 0;
+    long long trajectories = 0; // Trajectories simulated over all replicates
+};
+
+// A trajectory that reached a level, stopped between the errors and the sweeps of an active round
+struct splittingEntrance
+{
+    vuint64 state;
+    int round;
+};
+
+// One fixed-effort splitting estimate. The level function is the syndrome
+// weight after the data errors of each active round. Stage k runs effort
+// trajectories, started afresh (k = 0) or from entrances to level k - 1
+// chosen uniformly, until they reach level k or the last round. Those that
+// never reach it go through the readout phase, so
+//     estimate = sum_k (prod_{j<k} hits_j / effort) * failures_k / effort
+// covers failures at every level and is unbiased.
+double splittingReplicate(Code &code, const vuint64 &initialState, const runParameters &params,
+                          const int rounds, const vint &levels, const int effort, long long &trajectories)
+{
+    const int numberOfLevels = levels.size();
+    std::vector<splittingEntrance> starts;
+    double estimate = 0;
+    double reachProbability = 1;
+    for (int k = 0; k <= numberOfLevels; ++k)
+    {
+        std::vector<splittingEntrance> hits;
+        int failures = 0;
+        for (int i = 0; i < effort; ++i)
+        {
+            int r = 0;
+            bool midRound = false;
+            int sweepIndex = 0, sweepCount = 0;
+            if (k == 0)
+            {
+                code.restore(initialState);
+            }
+            else
+            {
+                std::uniform_int_distribution<int> distStart(0, starts.size() - 1);
+                const auto &start = starts[distStart(rnEngine)];
+                code.restore(start.state, sweepIndex, sweepCount);
+                r = start.round;
+                midRound = true;
+            }
+            code.seedRandom(randomSeed());
+            sweepScheduler schedule(params.sweepSchedule, code);
+            if (midRound)
+            {
+                schedule.index = sweepIndex;
+                schedule.count = sweepCount;
+            }
+            bool reached = false;
+            for (; r < rounds; ++r)
+            {
+                if (!midRound)
+                {
+                    activeRoundErrors(code, schedule, params);
+                }
+                midRound = false;
+                if (k < numberOfLevels && code.getSyndromeWeight() >= levels[k])
+                {
+                    hits.push_back({vuint64(), r});
+                    code.snapshot(hits.back().state, schedule.index, schedule.count);
+                    reached = true;
+                    break;
+                }
+                activeRoundSweeps(code, schedule, params);
+            }
+            if (!reached && !readoutPhase(code, schedule, params).success)
+            {
+                ++failures;
+            }
+            ++trajectories;
+        }
+        estimate += reachProbability * failures / effort;
+        reachProbability *= static_cast<double>(hits.size()) / effort;
+        if (hits.empty())
+        {
+            break;
+        }
+        starts = std::move(hits);
+    }
+    return estimate;
+}
+
+// Independent splitting replicates give the estimate and its confidence interval
+splittingResult splittingRun(const runParameters &params, const int rounds, const vint &levels,
+                             const int effort, const int replicates)
+{
+    if (rounds < 0)
+    {
+        throw std::invalid_argument("Rounds must be non-negative.");
+    }
+    if (effort < 1 || replicates < 2)
+    {
+        throw std::invalid_argument("Splitting needs at least one trajectory per level and two replicates.");
+    }
+    for (int k = 0; k < static_cast<int>(levels.size()); ++k)
+    {
+        if (levels[k] <= 0 || (k > 0 && levels[k] <= levels[k - 1]))
+        {
+            throw std::invalid_argument("Splitting levels must be positive and increasing.");
+        }
+    }
+    splittingResult result;
+    std::unique_ptr<Code> code = buildCode(params);
+    vuint64 initialState;
+    code->snapshot(initialState);
+    vdbl estimates;
+    for (int i = 0; i < replicates; ++i)
+    {
+        estimates.push_back(splittingReplicate(*code, initialState, params, rounds, levels, effort, result.trajectories));
+    }
+    result.failureRate = std::accumulate(estimates.begin(), estimates.end(), 0.0) / replicates;
+    double sumOfSquares = 0;
+    for (const double estimate : estimates)
+    {
+        sumOfSquares += (estimate - result.failureRate) * (estimate - result.failureRate);
+    }
+    result.standardError = std::sqrt(sumOfSquares / (replicates - 1) / replicates);
+    // The spread is estimated from few replicates, so the normal quantile would be too narrow
+    const double t = studentTQuantile(0.975, replicates - 1);
+    result.lower = std::max(0.0, result.failureRate - t * result.standardError);
+    result.upper = std::min(1.0, result.failureRate + t * result.standardError);
+    return result;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STACK_VECTOR_H
+#define STACK_VECTOR_H
+
+#include <array>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+// Vector with a fixed capacity stored inline so that the sweep
+// inner loop never touches the heap
+template <typename T, int N>
+class StackVector
+{
+private:
+  std::array<T, N> items;
+  int count = 0;
+
+public:
+  StackVector() = default;
+  StackVector(std::initializer_list<T> init)
+  {
+    for (const auto &item : init)
+    {
+      push_back(item);
+    }
+  }
+
+  void push_back(const T &item)
+  {
+    if (count == N)
+    {
+      throw std::length_error("StackVector capacity exceeded.");
+    }
+    items[count++] = item;
+  }
+  T *erase(T *position)
+  {
+    for (T *it = position; it + 1 < end(); ++it)
+    {
+      *it = *(it + 1);
+    }
+    --count;
+    return position;
+  }
+  void clear() { count = 0; }
+
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  T &operator[](const int i) { return items[i]; }
+  const T &operator[](const int i) const { return items[i]; }
+  T *begin() { return items.data(); }
+  T *end() { return items.data() + count; }
+  const T *begin() const { return items.data(); }
+  const T *end() const { return items.data() + count; }
+};
+
+template <typename T, int N>
+inline bool operator==(const StackVector<T, N> &lhs, const StackVector<T, N> &rhs)
+{
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+#endif
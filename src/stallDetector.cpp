@@ -0,0 +1,41 @@
+#include "stallDetector.h"
+#include <climits>
+#include <stdexcept>
+
+StallDetector::StallDetector(const int patience, const bool watchRepeats) : patience(patience), watchRepeats(watchRepeats)
+{
+    if (patience < 0)
+    {
+        throw std::invalid_argument("Stall patience must be non-negative.");
+    }
+    reset();
+}
+
+// Record the state after a readout sweep, returns why the trial should end
+// (stateHash is ignored unless repeats are watched)
+StallDetector::Verdict StallDetector::update(const uint64_t stateHash, const int syndromeWeight)
+{
+    if (watchRepeats && !seenStates.insert(stateHash).second)
+    {
+        return repeatedState;
+    }
+    if (patience == 0)
+    {
+        return progressing;
+    }
+    if (syndromeWeight < bestWeight)
+    {
+        bestWeight = syndromeWeight;
+        sweepsSinceBest = 0;
+        return progressing;
+    }
+    ++sweepsSinceBest;
+    return sweepsSinceBest >= patience ? noProgress : progressing;
+}
+
+void StallDetector::reset()
+{
+    bestWeight = INT_MAX;
+    sweepsSinceBest = 0;
+    seenStates.clear();
+}
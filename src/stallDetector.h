@@ -0,0 +1,36 @@
+#ifndef STALL_DETECTOR_H
+#define STALL_DETECTOR_H
+
+#include <cstdint>
+#include <unordered_set>
+
+// Watches the readout phase for trials that can no longer clear the syndrome.
+// If repeats are watched, a state seen before ends the trial: given a hash of
+// everything that determines the later sweeps, the readout is then in a cycle
+// that never clears the syndrome, so stopping changes no outcome. With a
+// positive patience, a syndrome weight that has not reached a new minimum for
+// patience sweeps also ends it; such a trial might still have succeeded
+// before the timeout, so callers record it as stalled.
+class StallDetector
+{
+private:
+  int patience;
+  bool watchRepeats;
+  int bestWeight;
+  int sweepsSinceBest;
+  std::unordered_set<uint64_t> seenStates;
+
+public:
+  enum Verdict : int8_t
+  {
+    progressing,
+    repeatedState,
+    noProgress
+  };
+
+  StallDetector(const int patience, const bool watchRepeats = false);
+  Verdict update(const uint64_t stateHash, const int syndromeWeight);
+  void reset();
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <cmath>
+#include <stdexcept>
+
+// Quantile of the standard normal distribution: Acklam's rational
+// approximation refined by one Halley step, accurate to double precision
+inline double normalQuantile(const double p)
+{
+    if (p <= 0 || p >= 1)
+    {
+        throw std::invalid_argument("Quantile probability must be between 0 and 1.");
+    }
+    const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                        1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                        6.680131188771972e+01, -1.328068155288572e+01};
+    const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                        3.754408661907416e+00};
+    const double tail = 0.02425;
+    double x;
+    if (p < tail || p > 1 - tail)
+    {
+        const double q = std::sqrt(-2 * std::log(p < tail ? p : 1 - p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        x = p < tail ? x : -x;
+    }
+    else
+    {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+    }
+    const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    const double u = e * std::sqrt(2 * M_PI) * std::exp(x * x / 2);
+    return x - u / (1 + x * u / 2);
+}
+
+// Quantile of Student's t distribution with df degrees of freedom, exact for
+// one and two, otherwise the Cornish-Fisher expansion about the normal
+// quantile (within 0.1% of the exact value at three degrees of freedom)
+inline double studentTQuantile(const double p, const int df)
+{
+    if (df < 1)
+    {
+        throw std::invalid_argument("Degrees of freedom must be positive.");
+    }
+    if (p <= 0 || p >= 1)
+    {
+        throw std::invalid_argument("Quantile probability must be between 0 and 1.");
+    }
+    if (df == 1)
+    {
+        return std::tan(M_PI * (p - 0.5));
+    }
+    if (df == 2)
+    {
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    }
+    const double z = normalQuantile(p);
+    const double z2 = z * z;
+    const double n = df;
+    const double g1 = z * (z2 + 1) / 4;
+    const double g2 = z * ((5 * z2 + 16) * z2 + 3) / 96;
+    const double g3 = z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / 384;
+    const double g4 = z * ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) / 92160;
+    return z + (g1 + (g2 + (g3 + g4 / n) / n) / n) / n;
+}
+
+#endif
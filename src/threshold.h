@@ -0,0 +1,134 @@
+#ifndef THRESHOLD_H
+#define THRESHOLD_H
+
+#include "batch.h"
+#include "statistics.h"
+
+// Failure rates of every L at one sampled p
+struct thresholdStep
+{
+    double p;
+    vint failures;   // One per L, in ascending L
+    vint trials;
+    int verdict = 0; // -1 below threshold, 1 above, 0 the curves could not be told apart
+};
+
+struct thresholdResult
+{
+    double lower;          // Bracket whose ends were placed on opposite sides of the crossing
+    double upper;
+    double estimate;       // Midpoint of the bracket, or the p where the curves could not be separated
+    bool resolved = false; // The bracket reached the requested width
+    std::vector<thresholdStep> steps;
+    long long trials = 0;  // Trials over every step and L
+};
+
+// Which side of the crossing a p is on, from the failures of the smallest
+// and largest L: -1 if the larger L fails significantly less often (below
+// threshold), 1 if more often, 0 if a two proportion z test with the given
+// critical value (the 97.5% normal quantile for a single test at the 95%
+// level) cannot tell. With no failures (or only failures) for both, p is taken
+// to be below (or above) threshold.
+int crossingSide(const int smallFailures, const int smallTrials, const int largeFailures, const int largeTrials,
+                 const double critical = normalQuantile(0.975))
+{
+    const int failures = smallFailures + largeFailures;
+    const int trials = smallTrials + largeTrials;
+    if (failures == 0)
+    {
+        return -1;
+    }
+    if (failures == trials)
+    {
+        return 1;
+    }
+    const double pooled = static_cast<double>(failures) / trials;
+    const double standardError = std::sqrt(pooled * (1 - pooled) * (1.0 / smallTrials + 1.0 / largeTrials));
+    const double z = (static_cast<double>(largeFailures) / largeTrials - static_cast<double>(smallFailures) / smallTrials) / standardError;
+    return z < -critical ? -1 : (z > critical ? 1 : 0);
+}
+
+// Bisect a p bracket for the crossing of the failure rate curves. At each
+// sampled p every L runs batches of trials (q follows p, as in the grid
+// files) until crossingSide can place it, so trials pile up close to the
+// crossing. The test is repeated after every batch, so its critical value is
+// Bonferroni adjusted over the budget / batchSize looks to keep each placement
+// at the 95% level. Both ends are placed first and the bracket is rejected
+// unless they are on opposite sides. The search stops once the bracket is at
+// most precision wide, or when a midpoint cannot be placed within budget
+// trials per L.
+thresholdResult thresholdSearch(const runParameters &common, vint ls, double lower, double upper, const int cycles,
+                                const double precision, const int batchSize, const int budget,
+                                std::ostream *log = nullptr)
+{
+    if (ls.size() < 2)
+    {
+        throw std::invalid_argument("At least two lattice sizes are required.");
+    }
+    if (lower < 0 || upper > 1 || lower >= upper)
+    {
+        throw std::invalid_argument("Invalid p bracket.");
+    }
+    if (precision <= 0 || batchSize <= 0 || budget < batchSize)
+    {
+        throw std::invalid_argument("Precision and batch size must be positive and the budget at least one batch.");
+    }
+    std::sort(ls.begin(), ls.end());
+    const int numberOfSizes = ls.size();
+    const double critical = normalQuantile(1 - 0.025 / (budget / batchSize));
+    thresholdResult result;
+    result.lower = lower;
+    result.upper = upper;
+    codeCache cache;
+    auto place = [&](const double p) {
+        thresholdStep step;
+        step.p = p;
+        step.failures.assign(numberOfSizes, 0);
+        step.trials.assign(numberOfSizes, 0);
+        while (step.verdict == 0 && step.trials[0] + batchSize <= budget)
+        {
+            for (int k = 0; k < numberOfSizes; ++k)
+            {
+                gridRow row{ls[k], step.p, step.p, cycles, batchSize, static_cast<int>(result.steps.size())};
+                batchResult batch = runGridRow(common, row, cache);
+                step.failures[k] += batchSize - batch.successes;
+                step.trials[k] += batchSize;
+                result.trials += batchSize;
+            }
+            step.verdict = crossingSide(step.failures.front(), step.trials.front(),
+                                        step.failures.back(), step.trials.back(), critical);
+        }
+        result.steps.push_back(step);
+        if (log)
+        {
+            *log << step.p << ", " << step.verdict;
+            for (int k = 0; k < numberOfSizes; ++k)
+            {
+                *log << ", " << step.failures[k] << "/" << step.trials[k];
+            }
+            *log << std::endl;
+        }
+        return step;
+    };
+
+    if (place(lower).verdict != -1 || place(upper).verdict != 1)
+    {
+        throw std::invalid_argument("The p bracket does not contain the crossing: its ends were not placed below "
+                                    "and above threshold.");
+    }
+    while (result.upper - result.lower > precision)
+    {
+        thresholdStep step = place((result.lower + result.upper) / 2);
+        if (step.verdict == 0)
+        {
+            result.estimate = step.p;
+            return result;
+        }
+        (step.verdict < 0 ? result.lower : result.upper) = step.p;
+    }
+    result.resolved = true;
+    result.estimate = (result.lower + result.upper) / 2;
+    return result;
+}
+
+#endif
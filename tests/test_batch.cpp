@@ -0,0 +1,233 @@
+#include "batch.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+TEST(readGrid, csv_with_header)
+{
+    std::stringstream input("L,p,cycles,trials,job_number\r\n4,0.19,0,100,0\r\n6,0.2,16,50,1\r\n");
+    auto rows = readGrid(input);
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[1].l, 6);
+    EXPECT_DOUBLE_EQ(rows[1].p, 0.2);
+    EXPECT_DOUBLE_EQ(rows[1].q, 0.2);
+    EXPECT_EQ(rows[1].cycles, 16);
+    EXPECT_EQ(rows[1].trials, 50);
+    EXPECT_EQ(rows[1].jobNumber, 1);
+
+    std::stringstream missing("L,p,trials,job_number\n4,0.19,100,0\n");
+    EXPECT_THROW(readGrid(missing), std::invalid_argument);
+}
+
+TEST(readGrid, params_txt)
+{
+    std::stringstream input("0 0 16 0.19 1000\n1 64 20 0.02 500\n\n");
+    auto rows = readGrid(input);
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[1].jobNumber, 1);
+    EXPECT_EQ(rows[1].cycles, 64);
+    EXPECT_EQ(rows[1].l, 20);
+    EXPECT_DOUBLE_EQ(rows[1].p, 0.02);
+    EXPECT_EQ(rows[1].trials, 500);
+
+    std::stringstream malformed("0 0 16\n");
+    EXPECT_THROW(readGrid(malformed), std::invalid_argument);
+}
+
+TEST(selectRows, indices_and_ranges)
+{
+    vint expected = {1, 3, 4, 5};
+    EXPECT_EQ(selectRows("1,3-5", 6), expected);
+    EXPECT_EQ(selectRows("all", 3), vint({0, 1, 2}));
+    EXPECT_THROW(selectRows("4-6", 6), std::invalid_argument);
+    EXPECT_THROW(selectRows("3-2", 6), std::invalid_argument);
+}
+
+TEST(runGrid, rows_share_a_code)
+{
+    std::stringstream input("L,p,cycles,trials,job_number\n4,0,4,5,0\n6,0,4,3,1\n4,0,2,2,2\n");
+    auto rows = readGrid(input);
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    codeCache cache;
+    std::vector<batchResult> batches;
+    for (int i : selectRows("all", rows.size()))
+    {
+        batches.push_back(runGridRow(common, rows[i], cache));
+    }
+    EXPECT_EQ(cache.codes.size(), 2);
+    ASSERT_EQ(batches.size(), 3);
+    EXPECT_EQ(batches[0].successes, 5);
+    EXPECT_EQ(batches[1].successes, 3);
+    EXPECT_EQ(batches[2].successes, 2);
+    // Defaults for the row's L
+    EXPECT_EQ(batches[1].params.sweepLimit, 2);
+    EXPECT_EQ(batches[1].params.timeout, 192);
+    EXPECT_EQ(batchFileName(batches[1]),
+              "L=6_N=4_p=0.0000_q=0.0000_schedule=AlternatingXz_sweepLimit=2_timeout=192_lattice=RhombicToric_correlated=False_rate=1_trials=3_job=1.json");
+}
+
+TEST(wilsonInterval, known_values)
+{
+    double lower, upper;
+    wilsonInterval(0, 10, lower, upper);
+    EXPECT_EQ(lower, 0);
+    EXPECT_NEAR(upper, 0.2775, 1e-4);
+    wilsonInterval(50, 100, lower, upper);
+    EXPECT_NEAR(lower, 0.4038, 1e-4);
+    EXPECT_NEAR(upper, 0.5962, 1e-4);
+    wilsonInterval(50, 100, lower, upper, 0.99);
+    EXPECT_NEAR(lower, 0.3753, 1e-4);
+    EXPECT_NEAR(upper, 0.6247, 1e-4);
+    EXPECT_THROW(wilsonInterval(50, 100, lower, upper, 1), std::invalid_argument);
+}
+
+TEST(runGridRow, stops_early)
+{
+    gridRow row{4, 0, 0, 4, 1000, 0};
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    codeCache cache;
+    // No failures, so the interval [0, upper] narrows to 0.05 after 73 trials
+    stoppingRule stopping;
+    stopping.absoluteWidth = 0.05;
+    auto batch = runGridRow(common, row, cache, stopping);
+    EXPECT_EQ(batch.results.size(), 73);
+    EXPECT_EQ(batch.lower, 0);
+    EXPECT_LE(batch.upper, 0.05);
+
+    // Far above threshold the row ends on its seventh failure
+    row.p = row.q = 0.3;
+    stopping = stoppingRule();
+    stopping.failureLimit = 7;
+    batch = runGridRow(common, row, cache, stopping);
+    EXPECT_EQ(batch.results.size() - batch.successes, 7);
+    EXPECT_FALSE(batch.results.back().success);
+}
+
+TEST(runGridRow, counts_stalled_trials)
+{
+    gridRow row{4, 0.3, 0.3, 4, 20, 0};
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1, false, 2};
+    codeCache cache;
+    auto batch = runGridRow(common, row, cache, stoppingRule());
+    int stalled = 0;
+    for (const auto &result : batch.results)
+    {
+        stalled += result.stalled;
+        EXPECT_FALSE(result.stalled && result.success);
+    }
+    EXPECT_GT(stalled, 0);
+    EXPECT_EQ(batch.stalled, stalled);
+    std::stringstream outcome;
+    writeOutcomeJson(outcome, batch);
+    EXPECT_NE(outcome.str().find("\"Stalled trials\": " + std::to_string(stalled)), std::string::npos);
+}
+
+TEST(runGridRow, streams_trials)
+{
+    std::string path = "test_batch_stream.bin";
+    std::remove(path.c_str());
+    gridRow row{4, 0, 0, 2, 10, 0};
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    codeCache cache;
+    {
+        ResultStream stream(path);
+        auto batch = runGridRow(common, row, cache, stoppingRule(), &stream);
+        EXPECT_TRUE(batch.results.empty());
+        EXPECT_EQ(batch.trials, 10);
+    }
+    std::ifstream input(path, std::ios::binary);
+    std::string types;
+    int packedTrials = 0;
+    unsigned char prefix[5];
+    while (input.read(reinterpret_cast<char *>(prefix), 5))
+    {
+        uint32_t length = prefix[0] | prefix[1] << 8 | prefix[2] << 16 | prefix[3] << 24;
+        std::string payload(length, ' ');
+        input.read(&payload[0], length);
+        types += prefix[4];
+        if (prefix[4] == 'T')
+        {
+            packedTrials += length / 13;
+            // Every trial succeeded with a clean syndrome
+            EXPECT_EQ(payload[0], 3);
+        }
+    }
+    EXPECT_EQ(types, "MHTE");
+    EXPECT_EQ(packedTrials, 10);
+    std::remove(path.c_str());
+}
+
+// Trial records of a result stream without their times
+std::vector<std::string> streamTrials(const std::string &path)
+{
+    std::ifstream input(path, std::ios::binary);
+    std::vector<std::string> trials;
+    unsigned char prefix[5];
+    while (input.read(reinterpret_cast<char *>(prefix), 5))
+    {
+        uint32_t length = prefix[0] | prefix[1] << 8 | prefix[2] << 16 | prefix[3] << 24;
+        std::string payload(length, ' ');
+        input.read(&payload[0], length);
+        for (uint32_t t = 0; prefix[4] == 'T' && t < length; t += 13)
+        {
+            trials.push_back(payload.substr(t, 9));
+        }
+    }
+    return trials;
+}
+
+TEST(runGridRow, resumes_from_checkpoint)
+{
+    gridRow row{6, 0.04, 0.04, 8, 12, 0};
+    runParameters common{0, 0, 0, 0, "random", 0, "rhombic_toric", false, false, 1};
+    std::string uninterrupted = "test_batch_whole.bin", resumed = "test_batch_resumed.bin";
+    std::string checkpointPath = "test_batch.checkpoint";
+    std::remove(uninterrupted.c_str());
+    std::remove(resumed.c_str());
+    rnEngine = pcg32(7);
+    {
+        codeCache cache;
+        ResultStream stream(uninterrupted);
+        runGridRow(common, row, cache, stoppingRule(), &stream);
+    }
+
+    rnEngine = pcg32(7);
+    Checkpointer checkpointer(checkpointPath, 0, configHash("test"));
+    // Nine saves per trial (one before it and one per round), so the 40th is
+    // in the third round of the fifth trial
+    checkpointer.interruptAfter = 40;
+    {
+        codeCache cache;
+        ResultStream stream(resumed);
+        EXPECT_THROW(runGridRow(common, row, cache, stoppingRule(), &stream, &checkpointer), checkpointInterrupt);
+    }
+    checkpointState state;
+    ASSERT_TRUE(checkpointer.load(state));
+    EXPECT_EQ(state.trials, 4);
+    EXPECT_EQ(state.round, 2);
+    // Anything left in the stream after the checkpoint is dropped on resuming
+    rnEngine = pcg32(99);
+    checkpointer.interruptAfter = -1;
+    {
+        codeCache cache;
+        ResultStream stream(resumed, state.streamLength);
+        auto batch = runGridRow(common, row, cache, stoppingRule(), &stream, &checkpointer, 0, &state);
+        EXPECT_EQ(batch.trials, 12);
+    }
+    EXPECT_EQ(streamTrials(resumed), streamTrials(uninterrupted));
+    EXPECT_EQ(streamTrials(resumed).size(), 12);
+
+    Checkpointer other(checkpointPath, 0, configHash("other"));
+    EXPECT_THROW(other.load(state), std::invalid_argument);
+    // Without a stream the finished trials would be lost on resuming
+    {
+        codeCache cache;
+        EXPECT_THROW(runGridRow(common, row, cache, stoppingRule(), nullptr, &checkpointer), std::invalid_argument);
+    }
+    checkpointer.remove();
+    EXPECT_FALSE(checkpointer.load(state));
+    std::remove(uninterrupted.c_str());
+    std::remove(resumed.c_str());
+}
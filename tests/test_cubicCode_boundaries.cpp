@@ -43,6 +43,34 @@ TEST(buildSyndromeIndices, syndrome_correct_edges)
     }
 }
 
+TEST(buildStabiliserTables, face_to_stabilisers_omits_boundary_edges)
+{
+    std::vector<int> ls = {4, 6, 8};
+    double p = 0.1;
+    for (int l : ls)
+    {
+        CubicCode code(l, p, p, true, 1);
+        auto &syndromeIndices = code.getSyndromeIndices();
+        auto &stabiliserIndices = code.getStabiliserIndices();
+        EXPECT_EQ(stabiliserIndices, vint(syndromeIndices.begin(), syndromeIndices.end()));
+        auto &faceToEdges = code.getLattice().getFaceToEdges();
+        auto &faceToStabilisers = code.getFaceToStabilisers();
+        ASSERT_EQ(faceToStabilisers.size(), faceToEdges.size());
+        for (int i = 0; i < faceToEdges.size(); ++i)
+        {
+            vint expectedEdges;
+            for (const int edge : faceToEdges[i])
+            {
+                if (syndromeIndices.find(edge) != syndromeIndices.end())
+                {
+                    expectedEdges.push_back(edge);
+                }
+            }
+            EXPECT_EQ(faceToStabilisers[i], expectedEdges);
+        }
+    }
+}
+
 TEST(buildSweepIndices, correct_indices_l4){
     int l = 4;
     double p = 0.1;
@@ -173,7 +201,7 @@ TEST(calculateSyndrome, correct_syndrome_one_error)
     code.calculateSyndrome();
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 10 || i == 29)
+        if (i == 4 || i == 12)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -193,7 +221,7 @@ TEST(calculateSyndrome, correct_syndrome_two_errors)
     code.calculateSyndrome();
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 29 || i == 40 || i == 122)
+        if (i == 12 || i == 17 || i == 52)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -213,7 +241,7 @@ TEST(calculateSyndrome, correct_syndrome_three_errors)
     code.calculateSyndrome();
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 122 || i == 141)
+        if (i == 52 || i == 60)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -369,7 +397,7 @@ TEST(sweep, all_directions_sweep_correctly)
     CubicCode code(4, 0.1, 0.1, true, 1);
     vstr sweepDirections = {"xyz", "xy", "xz", "yz", "-xyz", "-xy", "-xz", "-yz"};
     auto &syndrome = code.getSyndrome();
-    vvint expectedSyndromes = {{29, 40, 122}, {29, 40, 122}, {29, 40, 122}, {122, 141}, {10, 29}, {122, 141}, {29, 40, 122}, {10, 29}};
+    vvint expectedSyndromes = {{12, 17, 52}, {12, 17, 52}, {12, 17, 52}, {52, 60}, {4, 12}, {52, 60}, {12, 17, 52}, {4, 12}};
     for (int i = 0; i < sweepDirections.size(); ++i)
     {
         code.setError({0, 1});
@@ -389,7 +417,7 @@ TEST(sweep, all_directions_sweep_correctly)
         }
     }
     sweepDirections = {"yz", "-xyz", "-xy", "-yz"};
-    expectedSyndromes = {{122, 141}, {}, {}, {10, 29}};
+    expectedSyndromes = {{52, 60}, {}, {}, {4, 12}};
     for (int i = 0; i < sweepDirections.size(); ++i)
     {
         code.setError({0, 1});
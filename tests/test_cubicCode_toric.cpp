@@ -2,6 +2,7 @@
 #include "gtest/gtest.h"
 #include <string>
 #include <algorithm>
+#include <numeric>
 #include "cubicCode.h"
 
 TEST(neighbour, handles_valid_input)
@@ -24,12 +25,23 @@ TEST(edgeIndex, handles_valid_input)
     CubicToricLattice lattice = CubicToricLattice(l);
     int vertexIndex = 0;
     int sign = 1;
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "x", sign), 1);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "y", sign), 3);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "z", sign), 5);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "x", -sign), 29);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "y", -sign), 143);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "z", -sign), 705);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "x", sign), 0);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "y", sign), 1);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "z", sign), 2);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "x", -sign), 12);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "y", -sign), 61);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "z", -sign), 302);
+}
+
+TEST(denseToSparseEdge, inverts_dense_numbering)
+{
+    int l = 5;
+    CubicToricLattice lattice = CubicToricLattice(l);
+    EXPECT_EQ(lattice.denseToSparseEdge(lattice.edgeIndex(0, "y", -1)), 143);
+    for (int edge = 0; edge < 3 * l * l * l; ++edge)
+    {
+        EXPECT_EQ(lattice.denseEdgeIndex(lattice.denseToSparseEdge(edge)), edge);
+    }
 }
 
 TEST(generateDataError, statistics_correct)
@@ -59,7 +71,34 @@ TEST(generateMeasError, statistics_correct)
             ++errorCount;
         }
     }
-    EXPECT_NEAR(pow(l, 3) * 7 * q, errorCount, pow(l, 3) * 7 * q * tolerance);
-    // Note generate meas error can flip "phantom" syndrome indices, 
-    // but these are always cleared when we call calculateSyndrome()
-}
\ No newline at end of file
+    EXPECT_NEAR(pow(l, 3) * 3 * q, errorCount, pow(l, 3) * 3 * q * tolerance);
+}
+TEST(buildSweepIndices, every_vertex_on_torus)
+{
+    for (const int l : {4, 6})
+    {
+        CubicCode code(l, 0.1, 0.1, false, 1);
+        vint expectedIndices(pow(l, 3));
+        std::iota(expectedIndices.begin(), expectedIndices.end(), 0);
+        EXPECT_EQ(code.getSweepIndices(), expectedIndices);
+    }
+}
+
+TEST(sweep, corrects_single_qubit_errors)
+{
+    int l = 4;
+    vstr sweepDirections = {"xyz", "xy", "yz", "xz", "-xyz", "-xy", "-yz", "-xz"};
+    CubicCode code(l, 0.1, 0.1, false, 1);
+    for (int i = 0; i < 3 * pow(l, 3); ++i)
+    {
+        code.setError({i});
+        code.calculateSyndrome();
+        for (auto &sweepDirection : sweepDirections)
+        {
+            code.sweep(sweepDirection, true);
+            code.calculateSyndrome();
+        }
+        EXPECT_EQ(code.getSyndromeWeight(), 0);
+        EXPECT_TRUE(code.checkCorrection());
+    }
+}
@@ -0,0 +1,292 @@
+#include "decoder.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+
+TEST(multiHorizonRun, one_result_per_horizon)
+{
+    int l = 6;
+    auto results = multiHorizonRun(l, {8, 0, 4}, 0, 0, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1);
+    ASSERT_EQ(results.size(), 3);
+    for (const auto &result : results)
+    {
+        EXPECT_TRUE(result.success);
+        EXPECT_TRUE(result.cleanSyndrome);
+        EXPECT_EQ(result.readoutSweeps, 1);
+        EXPECT_EQ(result.abortRound, -1);
+    }
+}
+
+TEST(multiHorizonRun, abort_fails_remaining_horizons)
+{
+    int l = 6;
+    auto results = multiHorizonRun(l, {0, 4, 8}, 0.5, 0.5, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1,
+                                   false, -1, 1);
+    EXPECT_EQ(results[1].abortRound, 0);
+    EXPECT_EQ(results[2].abortRound, 0);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_FALSE(results[2].success);
+}
+
+TEST(multiHorizonRun, rejects_invalid_horizons)
+{
+    int l = 6;
+    EXPECT_THROW(multiHorizonRun(l, {}, 0.1, 0.1, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1),
+                 std::invalid_argument);
+    EXPECT_THROW(multiHorizonRun(l, {-1, 4}, 0.1, 0.1, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1),
+                 std::invalid_argument);
+}
+
+TEST(multiHorizonRun, records_every_round)
+{
+    int l = 6;
+    runParameters params{l, 0.02, 0.02, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    auto recorded = buildCode(params);
+    auto unrecorded = buildCode(params);
+    recorded->seedRandom(7);
+    unrecorded->seedRandom(7);
+    RoundRecorder recorder(1000);
+    auto result = multiHorizonRun(*recorded, params, {8}, &recorder)[0];
+    auto expected = multiHorizonRun(*unrecorded, params, {8})[0];
+    // Recording does not change the trial
+    EXPECT_EQ(result.success, expected.success);
+    EXPECT_EQ(result.readoutSweeps, expected.readoutSweeps);
+    EXPECT_EQ(recorded->getError(), unrecorded->getError());
+
+    ASSERT_EQ(recorder.size(), 8 + result.readoutSweeps);
+    EXPECT_EQ(recorder.dropped(), 0);
+    for (int i = 0; i < recorder.size(); ++i)
+    {
+        EXPECT_EQ(recorder[i].trial, 0);
+        EXPECT_EQ(recorder[i].readout, i >= 8);
+        EXPECT_EQ(recorder[i].round, i < 8 ? i : i - 7);
+        EXPECT_GE(recorder[i].facesFlipped, 0);
+    }
+    // Six sweeps in each direction of alternating_XZ, starting with xyz
+    EXPECT_STREQ(sweepDirectionNames[recorder[0].direction], "xyz");
+    EXPECT_STREQ(sweepDirectionNames[recorder[6].direction], "-xz");
+    const roundRecord &last = recorder[recorder.size() - 1];
+    EXPECT_EQ(last.errorWeight, static_cast<int>(recorded->getError().size()));
+    EXPECT_EQ(last.syndromeWeight, recorded->getSyndromeWeight());
+}
+
+TEST(oneRun, matches_single_horizon)
+{
+    int l = 6;
+    auto result = oneRun(l, 4, 0, 0, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1);
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result.cleanSyndrome);
+}
+
+TEST(commonNoiseRun, one_result_per_p_value)
+{
+    int l = 6;
+    runParameters params{l, 0, 0, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    auto results = commonNoiseRun(params, 8, {0, 0, 0}, {0, 0, 0});
+    ASSERT_EQ(results.size(), 3);
+    for (const auto &result : results)
+    {
+        EXPECT_TRUE(result.success);
+        EXPECT_EQ(result.readoutSweeps, 1);
+    }
+    EXPECT_THROW(commonNoiseRun(params, 8, {0.1, 0.2}, {0.1}), std::invalid_argument);
+}
+
+// Faces in exactly one of two errors
+std::set<int> errorChange(const FaceSet &before, const FaceSet &after)
+{
+    std::set<int> change;
+    std::set_symmetric_difference(before.begin(), before.end(), after.begin(), after.end(),
+                                  std::inserter(change, change.end()));
+    return change;
+}
+
+TEST(commonNoiseRun, new_errors_nested_in_p)
+{
+    int l = 6;
+    int rounds = 8;
+    runParameters params{l, 0, 0, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    vdbl pValues = {0.01, 0.05, 0.05};
+    std::vector<runParameters> trialParams(pValues.size(), params);
+    for (int k = 0; k < static_cast<int>(pValues.size()); ++k)
+    {
+        trialParams[k].p = trialParams[k].q = pValues[k];
+    }
+    std::vector<FaceSet> before(pValues.size());
+    std::vector<std::vector<std::set<int>>> newErrors(pValues.size(), std::vector<std::set<int>>(rounds));
+    commonNoiseRun(trialParams, rounds, [&](const int r, const int k, Code &code, const bool noiseAdded) {
+        if (noiseAdded)
+        {
+            newErrors[k][r] = errorChange(before[k], code.getError());
+        }
+        else
+        {
+            before[k] = code.getError();
+        }
+    });
+    int lowErrors = 0, highErrors = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        EXPECT_TRUE(std::includes(newErrors[1][r].begin(), newErrors[1][r].end(),
+                                  newErrors[0][r].begin(), newErrors[0][r].end()));
+        EXPECT_EQ(newErrors[1][r], newErrors[2][r]);
+        lowErrors += newErrors[0][r].size();
+        highErrors += newErrors[1][r].size();
+    }
+    EXPECT_GT(lowErrors, 0);
+    EXPECT_GT(highErrors, lowErrors);
+}
+
+TEST(commonNoiseRun, one_result_per_schedule)
+{
+    int l = 6;
+    runParameters params{l, 0, 0, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    auto results = commonNoiseRun(params, 8, vstr{"alternating_XZ", "rotating_XZ", "random"});
+    ASSERT_EQ(results.size(), 3);
+    for (const auto &result : results)
+    {
+        EXPECT_TRUE(result.success);
+    }
+    EXPECT_THROW(commonNoiseRun(params, 8, vstr{}), std::invalid_argument);
+}
+
+TEST(commonNoiseRun, schedules_share_injected_errors)
+{
+    int l = 6;
+    int rounds = 8;
+    runParameters params{l, 0.04, 0.04, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    vstr sweepSchedules = {"alternating_XZ", "rotating_XZ", "random"};
+    std::vector<runParameters> trialParams(sweepSchedules.size(), params);
+    for (int k = 0; k < static_cast<int>(sweepSchedules.size()); ++k)
+    {
+        trialParams[k].sweepSchedule = sweepSchedules[k];
+    }
+    std::vector<FaceSet> before(sweepSchedules.size());
+    std::vector<std::vector<std::set<int>>> dataErrors(sweepSchedules.size(), std::vector<std::set<int>>(rounds));
+    std::vector<std::vector<vint>> measErrors(sweepSchedules.size(), std::vector<vint>(rounds));
+    commonNoiseRun(trialParams, rounds, [&](const int r, const int k, Code &code, const bool noiseAdded) {
+        if (!noiseAdded)
+        {
+            before[k] = code.getError();
+            return;
+        }
+        dataErrors[k][r] = errorChange(before[k], code.getError());
+        // Measurement errors are where the syndrome differs from the error's own
+        std::vector<int8_t> measured = code.getSyndrome();
+        code.calculateSyndrome();
+        for (int edge = 0; edge < static_cast<int>(measured.size()); ++edge)
+        {
+            if (measured[edge] != code.getSyndrome()[edge])
+            {
+                measErrors[k][r].push_back(edge);
+            }
+        }
+        code.setSyndrome(measured);
+    });
+    int injected = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int k = 1; k < static_cast<int>(sweepSchedules.size()); ++k)
+        {
+            EXPECT_EQ(dataErrors[k][r], dataErrors[0][r]);
+            EXPECT_EQ(measErrors[k][r], measErrors[0][r]);
+        }
+        injected += dataErrors[0][r].size() + measErrors[0][r].size();
+    }
+    EXPECT_GT(injected, 0);
+}
+
+TEST(phaseTimers, cover_the_run_when_enabled)
+{
+    resetPhaseTimers();
+    int l = 6;
+    runParameters params{l, 0.02, 0.02, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    multiHorizonRun(params, {4, 8});
+#ifdef PHASE_TIMERS
+    EXPECT_GT(phaseSeconds(phaseConstruction), 0);
+    EXPECT_GT(phaseSeconds(phaseSweep), 0);
+    EXPECT_GT(phaseSeconds(phaseSnapshot), 0);
+#else
+    for (int k = 0; k < numberOfPhases; ++k)
+    {
+        EXPECT_EQ(phaseSeconds(static_cast<phase>(k)), 0);
+    }
+#endif
+}
+
+TEST(phaseCounters, count_what_is_available)
+{
+    resetPhaseTimers();
+    int l = 6;
+    runParameters params{l, 0.02, 0.02, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+    multiHorizonRun(params, {4});
+    for (int c = 0; c < numberOfCounters; ++c)
+    {
+        const counter event = static_cast<counter>(c);
+#ifdef PHASE_COUNTERS
+        // Virtual machines and containers often lack some counters
+        if (!counterAvailable(event))
+        {
+            EXPECT_EQ(phaseCount(phaseSweep, event), -1);
+            continue;
+        }
+        for (int k = 0; k < numberOfPhases; ++k)
+        {
+            EXPECT_GE(phaseCount(static_cast<phase>(k), event), 0);
+        }
+        if (event != counterPageFaults)
+        {
+            EXPECT_GT(phaseCount(phaseSweep, event), 0);
+        }
+#else
+        EXPECT_FALSE(counterAvailable(event));
+        EXPECT_EQ(phaseCount(phaseSweep, event), -1);
+#endif
+    }
+}
+
+TEST(multiHorizonRun, earlier_horizons_leave_random_schedule_unchanged)
+{
+    int l = 6;
+    runParameters params{l, 0.03, 0.03, l, "random", 32 * l, "rhombic_toric", false, false, 1};
+    auto several = buildCode(params);
+    auto single = buildCode(params);
+    several->seedRandom(3);
+    single->seedRandom(3);
+    rnEngine = pcg32(5);
+    auto result = multiHorizonRun(*several, params, {2, 5, 12}).back();
+    rnEngine = pcg32(5);
+    auto expected = multiHorizonRun(*single, params, {12})[0];
+    EXPECT_EQ(result.success, expected.success);
+    EXPECT_EQ(result.readoutSweeps, expected.readoutSweeps);
+    EXPECT_EQ(several->getError(), single->getError());
+}
+
+TEST(sweepScheduler, random_directions_restored_with_code_snapshot)
+{
+    int l = 4;
+    runParameters params{l, 0.03, 0.03, l, "random", 32 * l, "rhombic_toric", false, false, 1};
+    auto code = buildCode(params);
+    code->seedRandom(3);
+    sweepScheduler schedule(params.sweepSchedule, *code);
+    vuint64 buffer;
+    code->snapshot(buffer, schedule.index, schedule.count);
+    vstr expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        schedule.advance(schedule.count);
+        expected.push_back(schedule.direction());
+    }
+    // The global engine plays no part
+    rnEngine = pcg32(11);
+    code->restore(buffer, schedule.index, schedule.count);
+    vstr directions;
+    for (int i = 0; i < 20; ++i)
+    {
+        schedule.advance(schedule.count);
+        directions.push_back(schedule.direction());
+    }
+    EXPECT_EQ(directions, expected);
+}
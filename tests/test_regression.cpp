@@ -0,0 +1,94 @@
+#include "regression.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
+
+TEST(readRegressionCases, reads_golden_file)
+{
+    std::stringstream golden("name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed,successes\r\n"
+                             "a,rhombic_toric,6,0.02,0.01,6,50,alternating_XZ,false,true,7,48\r\n"
+                             "\r\n"
+                             "b,cubic_boundaries,4,0.03,0.03,4,20,xyz,true,false,18446744073709551615,\r\n");
+    auto cases = readRegressionCases(golden);
+    ASSERT_EQ(cases.size(), 2);
+    EXPECT_EQ(cases[0].name, "a");
+    EXPECT_EQ(cases[0].params.latticeType, "rhombic_toric");
+    EXPECT_EQ(cases[0].params.sweepSchedule, "alternating_XZ");
+    EXPECT_FALSE(cases[0].params.greedy);
+    EXPECT_TRUE(cases[0].params.correlatedErrors);
+    EXPECT_EQ(cases[0].row.l, 6);
+    EXPECT_DOUBLE_EQ(cases[0].row.p, 0.02);
+    EXPECT_DOUBLE_EQ(cases[0].row.q, 0.01);
+    EXPECT_EQ(cases[0].row.cycles, 6);
+    EXPECT_EQ(cases[0].row.trials, 50);
+    EXPECT_EQ(cases[0].seed, 7);
+    EXPECT_EQ(cases[0].successes, 48);
+    EXPECT_TRUE(cases[1].params.greedy);
+    EXPECT_EQ(cases[1].seed, 18446744073709551615ull);
+    EXPECT_EQ(cases[1].successes, -1);
+
+    std::stringstream written;
+    writeRegressionCases(written, cases);
+    auto reread = readRegressionCases(written);
+    ASSERT_EQ(reread.size(), 2);
+    EXPECT_EQ(reread[1].seed, cases[1].seed);
+    EXPECT_EQ(reread[0].successes, 48);
+    EXPECT_EQ(reread[1].successes, -1);
+}
+
+TEST(readRegressionCases, rejects_malformed_files)
+{
+    std::stringstream missingColumn("name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed\n");
+    EXPECT_THROW(readRegressionCases(missingColumn), std::invalid_argument);
+    std::stringstream shortRow("name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed,successes\n"
+                               "a,rhombic_toric,6,0.02,0.01,6,50\n");
+    EXPECT_THROW(readRegressionCases(shortRow), std::invalid_argument);
+    std::stringstream badBool("name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed,successes\n"
+                              "a,rhombic_toric,6,0.02,0.01,6,50,alternating_XZ,no,false,7,48\n");
+    EXPECT_THROW(readRegressionCases(badBool), std::invalid_argument);
+}
+
+TEST(runRegressionCase, seed_fixes_successes)
+{
+    std::stringstream golden("name,lattice_type,L,p,q,cycles,trials,sweep_schedule,greedy,correlated,seed,successes\n"
+                             "a,rhombic_toric,4,0.06,0.06,4,100,alternating_XZ,false,false,11,\n"
+                             "b,rhombic_boundaries,4,0.06,0.06,4,100,alternating_XZ,false,false,12,\n");
+    auto cases = readRegressionCases(golden);
+    auto first = runRegressionCase(cases[0]);
+    runRegressionCase(cases[1]);
+    auto second = runRegressionCase(cases[0]);
+    EXPECT_GT(first.successes, 0);
+    EXPECT_LT(first.successes, 100);
+    EXPECT_EQ(second.successes, first.successes);
+    EXPECT_GT(first.trialsPerSecond, 0);
+}
+
+TEST(compareOutcome, flags_regressions)
+{
+    regressionCase c;
+    c.name = "a";
+    c.successes = 90;
+    std::map<std::string, double> baseline = {{"a", 100}};
+    regressionOutcome outcome;
+    outcome.successes = 90;
+    outcome.trialsPerSecond = 95;
+    compareOutcome(outcome, c, baseline, 0.1);
+    EXPECT_TRUE(outcome.matches);
+    EXPECT_FALSE(outcome.slower);
+    EXPECT_DOUBLE_EQ(outcome.baseline, 100);
+
+    outcome.trialsPerSecond = 85;
+    compareOutcome(outcome, c, baseline, 0.1);
+    EXPECT_TRUE(outcome.slower);
+
+    outcome.successes = 89;
+    compareOutcome(outcome, c, {}, 0.1);
+    EXPECT_FALSE(outcome.matches);
+    EXPECT_FALSE(outcome.slower);
+    EXPECT_DOUBLE_EQ(outcome.baseline, 0);
+
+    c.successes = -1;
+    outcome.successes = 90;
+    compareOutcome(outcome, c, baseline, 0.1);
+    EXPECT_FALSE(outcome.matches);
+}
@@ -44,6 +44,34 @@ TEST(buildSyndromeIndices, syndrome_correct_edges)
     }
 }
 
+TEST(buildStabiliserTables, face_to_stabilisers_omits_boundary_edges)
+{
+    std::vector<int> ls = {4, 6, 8};
+    double p = 0.1;
+    for (int l : ls)
+    {
+        RhombicCode code(l, p, p, true, 1);
+        auto &syndromeIndices = code.getSyndromeIndices();
+        auto &stabiliserIndices = code.getStabiliserIndices();
+        EXPECT_EQ(stabiliserIndices, vint(syndromeIndices.begin(), syndromeIndices.end()));
+        auto &faceToEdges = code.getLattice().getFaceToEdges();
+        auto &faceToStabilisers = code.getFaceToStabilisers();
+        ASSERT_EQ(faceToStabilisers.size(), faceToEdges.size());
+        for (int i = 0; i < faceToEdges.size(); ++i)
+        {
+            vint expectedEdges;
+            for (const int edge : faceToEdges[i])
+            {
+                if (syndromeIndices.find(edge) != syndromeIndices.end())
+                {
+                    expectedEdges.push_back(edge);
+                }
+            }
+            EXPECT_EQ(faceToStabilisers[i], expectedEdges);
+        }
+    }
+}
+
 TEST(checkCorrection, handles_stabiliser_errors)
 {
     int l = 4;
@@ -472,6 +500,70 @@ TEST(buildSweepIndices, correct_number_of_indices)
     }
 }
 
+TEST(partitionSweepIndices, bulk_and_boundary_cover_sweep_indices)
+{
+    vint ls = {4, 6, 8, 10};
+    double p = 0.1;
+    for (int l : ls)
+    {
+        RhombicCode code(l, p, p, true, 1);
+        auto &lattice = code.getLattice();
+        vint &bulkSweepIndices = code.getBulkSweepIndices();
+        vint &boundarySweepIndices = code.getBoundarySweepIndices();
+        vint allIndices = bulkSweepIndices;
+        allIndices.insert(allIndices.end(), boundarySweepIndices.begin(), boundarySweepIndices.end());
+        std::sort(allIndices.begin(), allIndices.end());
+        EXPECT_EQ(allIndices, code.getSweepIndices());
+        for (const int vertexIndex : bulkSweepIndices)
+        {
+            cartesian4 coordinate = lattice.indexToCoordinate(vertexIndex);
+            if (coordinate.w == 0)
+            {
+                EXPECT_TRUE(coordinate.z != 1 && coordinate.z != l - 1);
+            }
+            else
+            {
+                EXPECT_TRUE(coordinate.y != 0 && coordinate.y != l - 2);
+            }
+        }
+    }
+}
+
+TEST(spannedFace, matches_face_vertices_on_bulk)
+{
+    const vstr directions = {"xyz", "xy", "yz", "xz", "-yz", "-xz", "-xy", "-xyz"};
+    vint ls = {4, 6};
+    double p = 0.1;
+    for (int l : ls)
+    {
+        RhombicCode code(l, p, p, true, 1);
+        auto &lattice = code.getLattice();
+        for (const int vertexIndex : code.getBulkSweepIndices())
+        {
+            for (auto &direction0 : directions)
+            {
+                for (auto &direction1 : directions)
+                {
+                    if (direction0 == direction1)
+                    {
+                        continue;
+                    }
+                    int expected = -1;
+                    try
+                    {
+                        aint4 vertices = code.faceVertices(vertexIndex, direction0, direction1);
+                        expected = lattice.findFace(vertices);
+                    }
+                    catch (const std::invalid_argument &e)
+                    {
+                    }
+                    EXPECT_EQ(code.spannedFace(vertexIndex, direction0, direction1), expected);
+                }
+            }
+        }
+    }
+}
+
 TEST(generateErrors, correlated_error_model_runs)
 {
     RhombicCode code(4, 0.1, 0.1, true, 1);
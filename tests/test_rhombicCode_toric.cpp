@@ -21,7 +21,7 @@ TEST(RhombicCode, syndrome_correct_size)
     {
         RhombicCode code(l, 0.1, 0.1, false, 1);
         auto syndrome = code.getSyndrome();
-        EXPECT_EQ(syndrome.size(), 2 * 7 * l * l * l);
+        EXPECT_EQ(syndrome.size(), 4 * l * l * l);
     }
 }
 
@@ -35,7 +35,7 @@ TEST(calculateSyndrome, correctly_calculates_error)
     code.setError(error);
     code.calculateSyndrome();
     auto syndrome = code.getSyndrome();
-    vint expectedUnsatisfied = {4, 6, 1516, 1518, 1547, 1722};
+    vint expectedUnsatisfied = {2, 3, 20, 22, 120, 123};
     for (int i = 0; i < syndrome.size(); ++i)
     {
         if (std::find(expectedUnsatisfied.begin(), expectedUnsatisfied.end(), i) != expectedUnsatisfied.end())
@@ -244,13 +244,29 @@ TEST(localFlip, flips_correctly_one_and_twice)
     RhombicCode code(l, p, p, false, 1);
     vint vs = {0, 72, 512, 519};
     code.localFlip(vs);
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    auto &flipBits = code.getFlipBits();
     EXPECT_EQ(flipBits[0], 1);
     code.localFlip(vs);
-    for (const int value : flipBits)
-    {
-        EXPECT_EQ(value, 0);
-    }
+    EXPECT_TRUE(flipBits.empty());
+}
+
+TEST(applyFlips, applies_each_face_once)
+{
+    int l = 8;
+    double p = 0.1;
+    RhombicCode code(l, p, p, false, 1);
+    vint vs = {0, 72, 512, 519};
+    code.setError({0, 5});
+    code.localFlip(vs);
+    code.localFlip(vs);
+    code.localFlip(vs);
+    code.applyFlips();
+    auto &error = code.getError();
+    EXPECT_EQ(error, std::set<int>({5}));
+    code.clearFlippedFaces();
+    EXPECT_TRUE(code.getFlipBits().empty());
+    code.applyFlips();
+    EXPECT_EQ(error, std::set<int>({5}));
 }
 
 TEST(findSweepEdges, correct_edges_one_error)
@@ -262,7 +278,7 @@ TEST(findSweepEdges, correct_edges_one_error)
     code.calculateSyndrome();
 
     // Full vertex
-    vstr upEdgesInSynd = code.findSweepEdges(40, "xyz");
+    svstr upEdgesInSynd = code.findSweepEdges(40, "xyz");
     EXPECT_TRUE(std::find(upEdgesInSynd.begin(), upEdgesInSynd.end(), "xyz") != upEdgesInSynd.end());
     EXPECT_TRUE(std::find(upEdgesInSynd.begin(), upEdgesInSynd.end(), "yz") != upEdgesInSynd.end());
     EXPECT_EQ(upEdgesInSynd.size(), 2);
@@ -423,7 +439,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     auto sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
     auto &flipBits = code.getFlipBits();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81)
         {
@@ -441,7 +457,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80)
         {
@@ -459,7 +475,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 82)
         {
@@ -479,7 +495,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81 || i == 82)
         {
@@ -497,7 +513,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 82)
         {
@@ -515,7 +531,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 81)
         {
@@ -535,7 +551,7 @@ TEST(sweepFullVertex, handles_qubits_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 81 || i == 82)
         {
@@ -557,18 +573,18 @@ TEST(sweepFullVertex, handles_measurement_errors_xy)
     // 3 sweep edges around vertex
     // xy, xyz, -yz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[189] = 1;
-    syndrome[191] = 1;
-    syndrome[501] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[108] = 1;
+    syndrome[45] = 1;
+    syndrome[30] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "xy");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "xy");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[80] ^ flipBits[82]);
     // std::cout << "80 = " << flipBits[80] << ", 82 = " << flipBits[82] << std::endl;
     // std::cout << "XOR = " << (flipBits[80] ^ flipBits[82]) << std::endl;
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 82)
         {
@@ -580,17 +596,17 @@ TEST(sweepFullVertex, handles_measurement_errors_xy)
     }
     // xy, -xz, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[501] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[30] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[81] ^ flipBits[82]);
     // std::cout << "80 = " << flipBits[81] << ", 82 = " << flipBits[82] << std::endl;
     // std::cout << "XOR = " << (flipBits[81] ^ flipBits[82]) << std::endl;
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81 || i == 82)
         {
@@ -602,17 +618,17 @@ TEST(sweepFullVertex, handles_measurement_errors_xy)
     }
     // xy, xyz, -xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[189] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[108] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[80] ^ flipBits[81]);
     // std::cout << "80 = " << flipBits[80] << ", 81 = " << flipBits[81] << std::endl;
     // std::cout << "XOR = " << (flipBits[80] ^ flipBits[81]) << std::endl;
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 81)
         {
@@ -624,10 +640,10 @@ TEST(sweepFullVertex, handles_measurement_errors_xy)
     }
     // xyz, -xz, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[501] = 1;
-    syndrome[189] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[30] = 1;
+    syndrome[108] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xy");
     code.sweepFullVertex(27, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
@@ -635,7 +651,7 @@ TEST(sweepFullVertex, handles_measurement_errors_xy)
                 (flipBits[80] && flipBits[82]) ^
                 (flipBits[81] && flipBits[82]));
     // std::cout << "80 = " << flipBits[80] << ", 81 = " << flipBits[81] << ", 82 = " << flipBits[82] << std::endl;
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80 || i == 81 || i == 82)
         {
@@ -660,7 +676,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     auto sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
     auto &flipBits = code.getFlipBits();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109)
         {
@@ -678,7 +694,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 204)
         {
@@ -696,7 +712,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 113)
         {
@@ -716,7 +732,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 204)
         {
@@ -734,7 +750,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 113)
         {
@@ -752,7 +768,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109)
         {
@@ -774,10 +790,10 @@ TEST(sweepHalfVertex, handles_measurement_errors_xy)
     // Three sweep edges at vertex 283
     // xyz, -yz and -xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[1981] = 1;
-    syndrome[480] = 1;
-    syndrome[265] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[268] = 1;
+    syndrome[270] = 1;
+    syndrome[271] = 1;
     code.setSyndrome(syndrome);
     auto sweepEdges = code.findSweepEdges(283, "xy");
     code.sweepHalfVertex(283, sweepEdges, "xy", {"xyz", "-xz", "-yz"});
@@ -785,7 +801,7 @@ TEST(sweepHalfVertex, handles_measurement_errors_xy)
     EXPECT_TRUE(flipBits[109] ^ flipBits[113] ^ flipBits[204]);
     // std::cout << "109 = " << flipBits[109] << ", 113 = " << flipBits[113] << ", 204 = " << flipBits[204] << std::endl;
     // std::cout << "XOR = " << (flipBits[109] ^ flipBits[113] ^ flipBits[204]) << std::endl;
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109 || i == 113 || i == 204)
         {
@@ -810,7 +826,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     auto sweepEdges = code.findSweepEdges(0, "-xy");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44)
         {
@@ -828,7 +844,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 87)
         {
@@ -846,7 +862,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 58)
         {
@@ -866,7 +882,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 87 || i == 58)
         {
@@ -884,7 +900,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 87 || i == 44)
         {
@@ -902,7 +918,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 58)
         {
@@ -922,7 +938,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 87 || i == 58 || i == 44)
         {
@@ -944,16 +960,16 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xy)
     // 3 sweep edges around vertex
     // -xy, xz, -xyz edges of vertex 0
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[555] = 1;
-    syndrome[6] = 1;
-    syndrome[889] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[61] = 1;
+    syndrome[51] = 1;
+    syndrome[252] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(0, "-xy");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(0, "-xy");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
     EXPECT_TRUE(flipBits[44] ^ flipBits[87]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 87)
         {
@@ -965,15 +981,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xy)
     }
     // -xy, -xyz, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[555] = 1;
-    syndrome[889] = 1;
-    syndrome[4] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[61] = 1;
+    syndrome[252] = 1;
+    syndrome[14] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
     EXPECT_TRUE(flipBits[44] ^ flipBits[58]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 58)
         {
@@ -985,15 +1001,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xy)
     }
     // -xy, yz, xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[555] = 1;
-    syndrome[4] = 1;
-    syndrome[6] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[61] = 1;
+    syndrome[14] = 1;
+    syndrome[51] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
     EXPECT_TRUE(flipBits[58] ^ flipBits[87]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 58 || i == 87)
         {
@@ -1005,17 +1021,17 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xy)
     }
     // -xyz, xz, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[889] = 1;
-    syndrome[4] = 1;
-    syndrome[6] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[252] = 1;
+    syndrome[14] = 1;
+    syndrome[51] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(0, "-xy");
     code.sweepFullVertex(0, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
     EXPECT_TRUE((flipBits[44] && flipBits[87]) ^
                 (flipBits[44] && flipBits[58]) ^
                 (flipBits[87] && flipBits[58]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 87 || i == 58)
         {
@@ -1040,7 +1056,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     auto sweepEdges = code.findSweepEdges(27, "xz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 83)
         {
@@ -1058,7 +1074,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 117)
         {
@@ -1076,7 +1092,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 117)
         {
@@ -1096,7 +1112,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83)
         {
@@ -1114,7 +1130,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79)
         {
@@ -1132,7 +1148,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 117)
         {
@@ -1152,7 +1168,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 83 || i == 117)
         {
@@ -1174,16 +1190,16 @@ TEST(sweepFullVertex, handles_measurement_errors_xz)
     // 3 sweep edges around vertex
     // xz, xyz, -yz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[189] = 1;
-    syndrome[195] = 1;
-    syndrome[501] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[108] = 1;
+    syndrome[95] = 1;
+    syndrome[30] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "xz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "xz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
     EXPECT_TRUE(flipBits[79] ^ flipBits[83]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 83)
         {
@@ -1195,15 +1211,15 @@ TEST(sweepFullVertex, handles_measurement_errors_xz)
     }
     // // xz, -xy, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[195] = 1;
-    syndrome[501] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[95] = 1;
+    syndrome[30] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
     EXPECT_TRUE(flipBits[83] ^ flipBits[117]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 117)
         {
@@ -1215,15 +1231,15 @@ TEST(sweepFullVertex, handles_measurement_errors_xz)
     }
     // // xz, xyz, -xy edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[195] = 1;
-    syndrome[189] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[95] = 1;
+    syndrome[108] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
     EXPECT_TRUE(flipBits[79] ^ flipBits[117]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 117)
         {
@@ -1235,17 +1251,17 @@ TEST(sweepFullVertex, handles_measurement_errors_xz)
     }
     // xyz, -xy, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[501] = 1;
-    syndrome[189] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[30] = 1;
+    syndrome[108] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xz");
     code.sweepFullVertex(27, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
     EXPECT_TRUE((flipBits[79] && flipBits[83]) ^
                 (flipBits[79] && flipBits[117]) ^
                 (flipBits[83] && flipBits[117]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 83 || i == 117)
         {
@@ -1270,7 +1286,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     auto sweepEdges = code.findSweepEdges(27, "-xz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81)
         {
@@ -1288,7 +1304,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 95)
         {
@@ -1306,7 +1322,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31)
         {
@@ -1326,7 +1342,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81 || i == 95)
         {
@@ -1344,7 +1360,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 81)
         {
@@ -1362,7 +1378,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 95)
         {
@@ -1382,7 +1398,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 81 || i == 95)
         {
@@ -1404,16 +1420,16 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xz)
     // 3 sweep edges around vertex
     // -xz, -xyz, yz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[193] = 1;
-    syndrome[490] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[106] = 1;
+    syndrome[24] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "-xz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "-xz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
     EXPECT_TRUE(flipBits[31] ^ flipBits[95]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 95)
         {
@@ -1425,15 +1441,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xz)
     }
     // // -xz, xy, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[193] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[106] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
     EXPECT_TRUE(flipBits[81] ^ flipBits[95]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 81 || i == 95)
         {
@@ -1445,15 +1461,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xz)
     }
     // // -xz, -xyz, xy edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[490] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[24] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
     EXPECT_TRUE(flipBits[31] ^ flipBits[81]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 81)
         {
@@ -1465,17 +1481,17 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xz)
     }
     // -xyz, xy, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[193] = 1;
-    syndrome[490] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[106] = 1;
+    syndrome[24] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xz");
     code.sweepFullVertex(27, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
     EXPECT_TRUE((flipBits[81] && flipBits[95]) ^
                 (flipBits[81] && flipBits[31]) ^
                 (flipBits[95] && flipBits[31]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31 || i == 81 || i == 95)
         {
@@ -1500,7 +1516,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     auto sweepEdges = code.findSweepEdges(27, "yz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 95)
         {
@@ -1518,7 +1534,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130 || i == 95)
         {
@@ -1536,7 +1552,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130 || i == 78)
         {
@@ -1556,7 +1572,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78)
         {
@@ -1574,7 +1590,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130)
         {
@@ -1592,7 +1608,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 95)
         {
@@ -1612,7 +1628,7 @@ TEST(sweepFullVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130 || i == 78 || i == 95)
         {
@@ -1634,16 +1650,16 @@ TEST(sweepFullVertex, handles_measurement_errors_yz)
     // 3 sweep edges around vertex
     // -xz, xyz, yz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[193] = 1;
-    syndrome[189] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[106] = 1;
+    syndrome[108] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "yz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "yz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
     EXPECT_TRUE(flipBits[78] ^ flipBits[95]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 95)
         {
@@ -1655,15 +1671,15 @@ TEST(sweepFullVertex, handles_measurement_errors_yz)
     }
     // -xz, -xy, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[604] = 1;
-    syndrome[193] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[89] = 1;
+    syndrome[106] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
     EXPECT_TRUE(flipBits[130] ^ flipBits[95]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130 || i == 95)
         {
@@ -1675,15 +1691,15 @@ TEST(sweepFullVertex, handles_measurement_errors_yz)
     }
     // yz, xyz, -xy edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[193] = 1;
-    syndrome[189] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[106] = 1;
+    syndrome[108] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
     EXPECT_TRUE(flipBits[130] ^ flipBits[78]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 130 || i == 78)
         {
@@ -1695,17 +1711,17 @@ TEST(sweepFullVertex, handles_measurement_errors_yz)
     }
     // xyz, -xy, -xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[189] = 1;
-    syndrome[524] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[108] = 1;
+    syndrome[43] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "yz");
     code.sweepFullVertex(27, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
     EXPECT_TRUE((flipBits[78] && flipBits[95]) ^
                 (flipBits[78] && flipBits[130]) ^
                 (flipBits[95] && flipBits[130]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 130 || i == 95)
         {
@@ -1730,7 +1746,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     auto sweepEdges = code.findSweepEdges(27, "-yz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 82)
         {
@@ -1748,7 +1764,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83)
         {
@@ -1766,7 +1782,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18)
         {
@@ -1786,7 +1802,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 82)
         {
@@ -1804,7 +1820,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 18)
         {
@@ -1822,7 +1838,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18 || i == 82)
         {
@@ -1842,7 +1858,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 82 || i == 18)
         {
@@ -1864,16 +1880,16 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_yz)
     // 3 sweep edges around vertex
     // xz, -xyz, -yz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[195] = 1;
-    syndrome[501] = 1;
-    syndrome[490] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[95] = 1;
+    syndrome[30] = 1;
+    syndrome[24] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "-yz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "-yz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
     EXPECT_TRUE(flipBits[83] ^ flipBits[18]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 83 || i == 18)
         {
@@ -1885,15 +1901,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_yz)
     }
     // xz, xy, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[195] = 1;
-    syndrome[501] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[95] = 1;
+    syndrome[30] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
     EXPECT_TRUE(flipBits[82] ^ flipBits[83]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 82 || i == 83)
         {
@@ -1905,15 +1921,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_yz)
     }
     // -yz, -xyz, xy edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[490] = 1;
-    syndrome[501] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[24] = 1;
+    syndrome[30] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
     EXPECT_TRUE(flipBits[82] ^ flipBits[18]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 82 || i == 18)
         {
@@ -1925,17 +1941,17 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_yz)
     }
     // xyz, -xy, -xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[195] = 1;
-    syndrome[490] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[95] = 1;
+    syndrome[24] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-yz");
     code.sweepFullVertex(27, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
     EXPECT_TRUE((flipBits[18] && flipBits[82]) ^
                 (flipBits[18] && flipBits[83]) ^
                 (flipBits[82] && flipBits[83]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18 || i == 83 || i == 82)
         {
@@ -1960,7 +1976,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     auto sweepEdges = code.findSweepEdges(27, "xyz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 80)
         {
@@ -1978,7 +1994,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79)
         {
@@ -1996,7 +2012,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78)
         {
@@ -2016,7 +2032,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 80)
         {
@@ -2034,7 +2050,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 79)
         {
@@ -2052,7 +2068,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 80)
         {
@@ -2071,7 +2087,7 @@ TEST(sweepFullVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "yz", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 80 || i == 79)
         {
@@ -2093,16 +2109,16 @@ TEST(sweepFullVertex, handles_measurement_errors_xyz)
     // 3 sweep edges around vertex
     // xyz, yz and xz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[189] = 1;
-    syndrome[193] = 1;
-    syndrome[195] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[108] = 1;
+    syndrome[106] = 1;
+    syndrome[95] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "xyz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "xyz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "xz", "yz"});
     EXPECT_TRUE(flipBits[78] ^ flipBits[79]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 79)
         {
@@ -2114,15 +2130,15 @@ TEST(sweepFullVertex, handles_measurement_errors_xyz)
     }
     // xyz, xy, yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[189] = 1;
-    syndrome[193] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[108] = 1;
+    syndrome[106] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "xz", "yz"});
     EXPECT_TRUE(flipBits[80] ^ flipBits[78]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 80)
         {
@@ -2134,15 +2150,15 @@ TEST(sweepFullVertex, handles_measurement_errors_xyz)
     }
     // xyz, xy, xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[189] = 1;
-    syndrome[195] = 1;
-    syndrome[191] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[108] = 1;
+    syndrome[95] = 1;
+    syndrome[45] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "xz", "yz"});
     EXPECT_TRUE(flipBits[79] ^ flipBits[80]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 79 || i == 80)
         {
@@ -2154,17 +2170,17 @@ TEST(sweepFullVertex, handles_measurement_errors_xyz)
     }
     // yz, xy, xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[191] = 1;
-    syndrome[195] = 1;
-    syndrome[193] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[45] = 1;
+    syndrome[95] = 1;
+    syndrome[106] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "xyz");
     code.sweepFullVertex(27, sweepEdges, "xyz", {"xy", "xz", "yz"});
     EXPECT_TRUE((flipBits[78] && flipBits[79]) ^
                 (flipBits[78] && flipBits[80]) ^
                 (flipBits[79] && flipBits[80]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 78 || i == 79 || i == 80)
         {
@@ -2189,7 +2205,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     auto sweepEdges = code.findSweepEdges(27, "-xyz");
     auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18 || i == 31)
         {
@@ -2207,7 +2223,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68 || i == 31)
         {
@@ -2225,7 +2241,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68 || i == 18)
         {
@@ -2246,7 +2262,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68 || i == 31 || i == 18)
         {
@@ -2266,7 +2282,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68)
         {
@@ -2284,7 +2300,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 31)
         {
@@ -2302,7 +2318,7 @@ TEST(sweepFullVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18)
         {
@@ -2324,16 +2340,16 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xyz)
     // 3 sweep edges around vertex
     // -xyz, -yz and -xz edges of vertex 27
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[490] = 1;
-    syndrome[501] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[24] = 1;
+    syndrome[30] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
-    vstr sweepEdges = code.findSweepEdges(27, "-xyz");
-    std::vector<int8_t> &flipBits = code.getFlipBits();
+    svstr sweepEdges = code.findSweepEdges(27, "-xyz");
+    auto &flipBits = code.getFlipBits();
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[18] ^ flipBits[31]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18 || i == 31)
         {
@@ -2345,15 +2361,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xyz)
     }
     // -xyz, -xy, -yz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[490] = 1;
-    syndrome[604] = 1;
-    syndrome[501] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[24] = 1;
+    syndrome[89] = 1;
+    syndrome[30] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[68] ^ flipBits[18]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68 || i == 18)
         {
@@ -2365,15 +2381,15 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xyz)
     }
     // -xyz, -xy, -xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[490] = 1;
-    syndrome[604] = 1;
-    syndrome[524] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[24] = 1;
+    syndrome[89] = 1;
+    syndrome[43] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-xz", "-yz"});
     EXPECT_TRUE(flipBits[68] ^ flipBits[31]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 68 || i == 31)
         {
@@ -2385,17 +2401,17 @@ TEST(sweepFullVertex, handles_measurement_errors_minus_xyz)
     }
     // -yz, -xy, -xz edges of vertex 27
     code.clearFlipBits();
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[501] = 1;
-    syndrome[524] = 1;
-    syndrome[604] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[30] = 1;
+    syndrome[43] = 1;
+    syndrome[89] = 1;
     code.setSyndrome(syndrome);
     sweepEdges = code.findSweepEdges(27, "-xyz");
     code.sweepFullVertex(27, sweepEdges, "-xyz", {"-xy", "-xz", "-yz"});
     EXPECT_TRUE((flipBits[31] && flipBits[18]) ^
                 (flipBits[31] && flipBits[68]) ^
                 (flipBits[18] && flipBits[68]));
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 18 || i == 31 || i == 68)
         {
@@ -2420,7 +2436,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     auto sweepEdges = code.findSweepEdges(309, "-xy");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 407)
         {
@@ -2438,7 +2454,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 277)
         {
@@ -2456,7 +2472,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276)
         {
@@ -2476,7 +2492,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276)
         {
@@ -2494,7 +2510,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 277)
         {
@@ -2512,7 +2528,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xy)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 407)
         {
@@ -2538,7 +2554,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     auto sweepEdges = code.findSweepEdges(283, "xz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 204)
         {
@@ -2556,7 +2572,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 308)
         {
@@ -2574,7 +2590,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 310)
         {
@@ -2594,7 +2610,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 204)
         {
@@ -2612,7 +2628,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 310)
         {
@@ -2630,7 +2646,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 308)
         {
@@ -2656,7 +2672,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     auto sweepEdges = code.findSweepEdges(309, "-xz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 406)
         {
@@ -2674,7 +2690,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 278)
         {
@@ -2692,7 +2708,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276)
         {
@@ -2712,7 +2728,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276)
         {
@@ -2730,7 +2746,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 278)
         {
@@ -2748,7 +2764,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "xy", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 406)
         {
@@ -2774,7 +2790,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     auto sweepEdges = code.findSweepEdges(283, "yz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109)
         {
@@ -2792,7 +2808,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 308)
         {
@@ -2810,7 +2826,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 309)
         {
@@ -2830,7 +2846,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109)
         {
@@ -2848,7 +2864,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 309)
         {
@@ -2866,7 +2882,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 308)
         {
@@ -2892,7 +2908,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     auto sweepEdges = code.findSweepEdges(309, "-yz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 393)
         {
@@ -2910,7 +2926,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 278)
         {
@@ -2928,7 +2944,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 277)
         {
@@ -2948,7 +2964,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 277)
         {
@@ -2966,7 +2982,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 278)
         {
@@ -2984,7 +3000,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_yz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 393)
         {
@@ -3010,7 +3026,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     auto sweepEdges = code.findSweepEdges(309, "xyz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 393)
         {
@@ -3028,7 +3044,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 406)
         {
@@ -3046,7 +3062,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 407)
         {
@@ -3066,7 +3082,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 407)
         {
@@ -3084,7 +3100,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 406)
         {
@@ -3102,7 +3118,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "xz", "yz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 393)
         {
@@ -3128,7 +3144,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     auto sweepEdges = code.findSweepEdges(283, "-xyz");
     auto &flipBits = code.getFlipBits();
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 113)
         {
@@ -3146,7 +3162,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 309)
         {
@@ -3164,7 +3180,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 310)
         {
@@ -3184,7 +3200,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 113)
         {
@@ -3202,7 +3218,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 309)
         {
@@ -3220,7 +3236,7 @@ TEST(sweepHalfVertex, handles_qubit_errors_minus_xyz)
     code.calculateSyndrome();
     sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 310)
         {
@@ -3242,16 +3258,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_xz)
     // Three sweep edges at vertex 283
     // xyz, -yz and -xy edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[1981] = 1;
-    syndrome[480] = 1;
-    syndrome[723] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[268] = 1;
+    syndrome[270] = 1;
+    syndrome[269] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(283, "xz");
     code.sweepHalfVertex(283, sweepEdges, "xz", {"xyz", "-xy", "-yz"});
     EXPECT_TRUE(flipBits[310] ^ flipBits[308] ^ flipBits[204]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 204 || i == 308 || i == 310)
         {
@@ -3272,16 +3288,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_yz)
     // Three sweep edges at vertex 283
     // xyz, -xy and -xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[1981] = 1;
-    syndrome[723] = 1;
-    syndrome[265] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[268] = 1;
+    syndrome[269] = 1;
+    syndrome[271] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(283, "yz");
     code.sweepHalfVertex(283, sweepEdges, "yz", {"xyz", "-xy", "-xz"});
     EXPECT_TRUE(flipBits[109] ^ flipBits[308] ^ flipBits[309]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 109 || i == 309 || i == 308)
         {
@@ -3302,16 +3318,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_minus_xyz)
     // Three sweep edges at vertex 283
     // -xy, -yz and -xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[723] = 1;
-    syndrome[480] = 1;
-    syndrome[265] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[269] = 1;
+    syndrome[270] = 1;
+    syndrome[271] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(283, "-xyz");
     code.sweepHalfVertex(283, sweepEdges, "-xyz", {"-xy", "-yz", "-xz"});
     EXPECT_TRUE(flipBits[113] ^ flipBits[309] ^ flipBits[310]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 113 || i == 309 || i == 310)
         {
@@ -3332,16 +3348,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_minus_xy)
     // Three sweep edges at vertex 309
     // -xyz, yz and xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[651] = 1;
-    syndrome[2167] = 1;
-    syndrome[2169] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[372] = 1;
+    syndrome[374] = 1;
+    syndrome[375] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(309, "-xy");
     code.sweepHalfVertex(309, sweepEdges, "-xy", {"-xyz", "yz", "xz"});
     EXPECT_TRUE(flipBits[276] ^ flipBits[277] ^ flipBits[407]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276 || i == 277 || i == 407)
         {
@@ -3362,16 +3378,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_minus_xz)
     // Three sweep edges at vertex 309
     // -xyz, yz and xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[651] = 1;
-    syndrome[2167] = 1;
-    syndrome[2165] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[372] = 1;
+    syndrome[374] = 1;
+    syndrome[373] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(309, "-xz");
     code.sweepHalfVertex(309, sweepEdges, "-xz", {"-xyz", "yz", "xy"});
     EXPECT_TRUE(flipBits[276] ^ flipBits[278] ^ flipBits[406]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 276 || i == 278 || i == 406)
         {
@@ -3392,16 +3408,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_minus_yz)
     // Three sweep edges at vertex 309
     // -xyz, yz and xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[651] = 1;
-    syndrome[2169] = 1;
-    syndrome[2165] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[372] = 1;
+    syndrome[375] = 1;
+    syndrome[373] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(309, "-yz");
     code.sweepHalfVertex(309, sweepEdges, "-yz", {"-xyz", "xy", "xz"});
     EXPECT_TRUE(flipBits[277] ^ flipBits[278] ^ flipBits[393]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 277 || i == 278 || i == 393)
         {
@@ -3422,16 +3438,16 @@ TEST(sweepHalfVertex, handles_measurement_errors_xyz)
     // Three sweep edges at vertex 309
     // -xyz, yz and xz edges
     std::vector<int8_t> syndrome;
-    syndrome.assign(14 * l * l * l, 0);
-    syndrome[2167] = 1;
-    syndrome[2169] = 1;
-    syndrome[2165] = 1;
+    syndrome.assign(4 * l * l * l, 0);
+    syndrome[374] = 1;
+    syndrome[375] = 1;
+    syndrome[373] = 1;
     code.setSyndrome(syndrome);
     auto &flipBits = code.getFlipBits();
     auto sweepEdges = code.findSweepEdges(309, "xyz");
     code.sweepHalfVertex(309, sweepEdges, "xyz", {"xy", "yz", "xz"});
     EXPECT_TRUE(flipBits[406] ^ flipBits[407] ^ flipBits[393]);
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 406 || i == 407 || i == 393)
         {
@@ -3443,6 +3459,35 @@ TEST(sweepHalfVertex, handles_measurement_errors_xyz)
     }
 }
 
+TEST(setTileSize, same_flips_as_index_order)
+{
+    int l = 8;
+    double p = 0.1;
+    RhombicCode code(l, p, p, false, 1);
+    RhombicCode tiledCode(l, p, p, false, 1);
+    tiledCode.setTileSize(3);
+    vint bulkSweepIndices = tiledCode.getBulkSweepIndices();
+    std::sort(bulkSweepIndices.begin(), bulkSweepIndices.end());
+    EXPECT_EQ(bulkSweepIndices, code.getBulkSweepIndices());
+    // Single face errors are swept deterministically
+    for (int face = 0; face < 3 * l * l * l; face += 37)
+    {
+        for (const std::string direction : {"xyz", "-xyz", "xy", "-yz"})
+        {
+            code.setError({face});
+            code.calculateSyndrome();
+            code.sweep(direction, true);
+            tiledCode.setError({face});
+            tiledCode.calculateSyndrome();
+            tiledCode.sweep(direction, true);
+            EXPECT_EQ(tiledCode.getFlipBits(), code.getFlipBits());
+            EXPECT_EQ(tiledCode.getError(), code.getError());
+        }
+    }
+    tiledCode.setTileSize(0);
+    EXPECT_EQ(tiledCode.getBulkSweepIndices(), code.getBulkSweepIndices());
+}
+
 TEST(sweep, handles_qubit_errors_xyz)
 {
     int l = 4;
@@ -3456,7 +3501,7 @@ TEST(sweep, handles_qubit_errors_xyz)
     auto &error = code.getError();
     code.sweep("xyz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 45)
         {
@@ -3472,7 +3517,7 @@ TEST(sweep, handles_qubit_errors_xyz)
     EXPECT_TRUE(error.find(151) != error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 811 || i == 357 || i == 363 || i == 107 || i == 105 || i == 555)
+        if (i == 207 || i == 204 || i == 255 || i == 253 || i == 60 || i == 61)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3483,7 +3528,7 @@ TEST(sweep, handles_qubit_errors_xyz)
     }
     code.sweep("xyz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 151)
         {
@@ -3515,7 +3560,7 @@ TEST(sweep, handles_qubit_errors_minus_xyz)
     auto &error = code.getError();
     code.sweep("-xyz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 151)
         {
@@ -3531,7 +3576,7 @@ TEST(sweep, handles_qubit_errors_minus_xyz)
     EXPECT_TRUE(error.find(151) == error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 363 || i == 107 || i == 884 || i == 888)
+        if (i == 255 || i == 253 || i == 249 || i == 251)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3542,7 +3587,7 @@ TEST(sweep, handles_qubit_errors_minus_xyz)
     }
     code.sweep("-xyz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 45)
         {
@@ -3573,7 +3618,7 @@ TEST(sweep, handles_qubit_errors_xy)
     auto &error = code.getError();
     code.sweep("xy", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 44 || i == 45)
         {
@@ -3589,7 +3634,7 @@ TEST(sweep, handles_qubit_errors_xy)
     EXPECT_TRUE(error.find(151) != error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 357 || i == 811 || i == 889 || i == 363)
+        if (i == 204 || i == 207 || i == 252 || i == 255)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3600,7 +3645,7 @@ TEST(sweep, handles_qubit_errors_xy)
     }
     code.sweep("xy", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 151)
         {
@@ -3631,7 +3676,7 @@ TEST(sweep, handles_qubit_errors_minus_xy)
     auto &error = code.getError();
     code.sweep("-xy", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 151)
         {
@@ -3647,7 +3692,7 @@ TEST(sweep, handles_qubit_errors_minus_xy)
     EXPECT_TRUE(error.find(151) == error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 363 || i == 889 || i == 884 || i == 888 || i == 105 || i == 555)
+        if (i == 255 || i == 252 || i == 249 || i == 251 || i == 60 || i == 61)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3658,7 +3703,7 @@ TEST(sweep, handles_qubit_errors_minus_xy)
     }
     code.sweep("-xy", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 45 || i == 44)
         {
@@ -3690,7 +3735,7 @@ TEST(sweep, handles_qubit_errors_xz)
     auto &error = code.getError();
     code.sweep("xz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 259 || i == 478)
         {
@@ -3706,7 +3751,7 @@ TEST(sweep, handles_qubit_errors_xz)
     EXPECT_TRUE(error.find(478) == error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 812 || i == 814 || i == 2326 || i == 2072)
+        if (i == 464 || i == 321 || i == 465 || i == 320)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3717,7 +3762,7 @@ TEST(sweep, handles_qubit_errors_xz)
     }
     code.sweep("xz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 350)
         {
@@ -3748,7 +3793,7 @@ TEST(sweep, handles_qubit_errors_minus_xz)
     auto &error = code.getError();
     code.sweep("-xz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 348 || i == 389)
         {
@@ -3766,8 +3811,8 @@ TEST(sweep, handles_qubit_errors_minus_xz)
     EXPECT_TRUE(error.find(389) != error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 816 || i == 814 || i == 602 || i == 608 ||
-            i == 2118 || i == 902 || i == 1108 || i == 2317)
+        if (i == 462 || i == 321 || i == 344 || i == 323 ||
+            i == 346 || i == 491 || i == 489 || i == 460)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3801,7 +3846,7 @@ TEST(sweep, handles_qubit_errors_yz)
     auto &error = code.getError();
     code.sweep("yz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 351 || i == 389)
         {
@@ -3819,8 +3864,8 @@ TEST(sweep, handles_qubit_errors_yz)
     EXPECT_TRUE(error.find(389) != error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 812 || i == 2071 || i == 602 || i == 2067 ||
-            i == 2118 || i == 902 || i == 1108 || i == 2328)
+        if (i == 464 || i == 319 || i == 344 || i == 317 ||
+            i == 346 || i == 491 || i == 489 || i == 466)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3856,7 +3901,7 @@ TEST(sweep, handles_qubit_errors_minus_yz)
     auto &error = code.getError();
     code.sweep("-yz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 259 || i == 478)
         {
@@ -3872,7 +3917,7 @@ TEST(sweep, handles_qubit_errors_minus_yz)
     EXPECT_TRUE(error.find(478) == error.end());
     for (int i = 0; i < syndrome.size(); ++i)
     {
-        if (i == 812 || i == 814 || i == 2326 || i == 2072)
+        if (i == 464 || i == 321 || i == 465 || i == 320)
         {
             EXPECT_EQ(syndrome[i], 1);
         }
@@ -3883,7 +3928,7 @@ TEST(sweep, handles_qubit_errors_minus_yz)
     }
     code.sweep("-yz", true);
     code.calculateSyndrome();
-    for (int i = 0; i < flipBits.size(); ++i)
+    for (int i = 0; i < code.getNumberOfFaces(); ++i)
     {
         if (i == 350)
         {
@@ -4000,4 +4045,196 @@ TEST(sweep, multiple_sweeps_per_syndrome)
         EXPECT_EQ(finalErrorLowRate, finalErrorHighRate);
         EXPECT_EQ(lowRateSyndrome, highRateSyndrome);
     }
-}
\ No newline at end of file
+}
+TEST(sweep, in_place_syndrome_matches_recalculation)
+{
+    int l = 6;
+    double p = 0.1;
+    RhombicCode code(l, p, p, false, 1);
+    code.setInPlace(true);
+    std::vector<std::string> directions = {"xyz", "-xy", "yz", "-xz"};
+    std::vector<std::set<int>> testErrors = {{22}, {1}, {17}, {41, 42, 43}, {50, 27, 47, 11, 1}, {20, 10}, {11, 15, 6, 2, 22, 45, 40, 21, 0, 3, 33, 5}};
+    for (auto &error : testErrors)
+    {
+        code.setError(error);
+        code.calculateSyndrome();
+        for (auto &direction : directions)
+        {
+            code.sweep(direction, true);
+            auto inPlaceSyndrome = code.getSyndrome();
+            code.calculateSyndrome();
+            EXPECT_EQ(inPlaceSyndrome, code.getSyndrome());
+        }
+    }
+}
+
+TEST(spannedFace, matches_face_vertices_on_bulk)
+{
+    const vstr directions = {"xyz", "xy", "yz", "xz", "-yz", "-xz", "-xy", "-xyz"};
+    vint ls = {4, 6};
+    double p = 0.1;
+    for (int l : ls)
+    {
+        RhombicCode code(l, p, p, false, 1);
+        auto &lattice = code.getLattice();
+        for (const int vertexIndex : code.getBulkSweepIndices())
+        {
+            for (auto &direction0 : directions)
+            {
+                for (auto &direction1 : directions)
+                {
+                    if (direction0 == direction1)
+                    {
+                        continue;
+                    }
+                    int expected = -1;
+                    try
+                    {
+                        aint4 vertices = code.faceVertices(vertexIndex, direction0, direction1);
+                        expected = lattice.findFace(vertices);
+                    }
+                    catch (const std::invalid_argument &e)
+                    {
+                    }
+                    EXPECT_EQ(code.spannedFace(vertexIndex, direction0, direction1), expected);
+                }
+            }
+        }
+    }
+}
+
+TEST(getSyndromeWeight, counts_unsatisfied_stabilisers)
+{
+    int l = 6;
+    double p = 0.1;
+    RhombicCode code(l, p, p, false, 1);
+    auto countUnsatisfied = [&code]() {
+        auto &syndrome = code.getSyndrome();
+        return std::count(syndrome.begin(), syndrome.end(), 1);
+    };
+    code.generateDataError(false);
+    code.calculateSyndrome();
+    EXPECT_EQ(code.getSyndromeWeight(), countUnsatisfied());
+    code.generateMeasError();
+    EXPECT_EQ(code.getSyndromeWeight(), countUnsatisfied());
+    code.setInPlace(true);
+    code.sweep("xyz", true);
+    EXPECT_EQ(code.getSyndromeWeight(), countUnsatisfied());
+}
+
+TEST(getLogicalParity, matches_logical_operators)
+{
+    int l = 6;
+    double p = 0.05;
+    RhombicCode code(l, p, p, false, 1);
+    auto logicals = code.getLogicals();
+    for (int r = 0; r < 20; ++r)
+    {
+        code.generateDataError(false);
+        code.calculateSyndrome();
+        code.sweep("xyz", false);
+        auto &error = code.getError();
+        int8_t expectedParity = 0;
+        for (int k = 0; k < logicals.size(); ++k)
+        {
+            for (const int faceIndex : logicals[k])
+            {
+                if (error.find(faceIndex) != error.end())
+                {
+                    expectedParity ^= 1 << k;
+                }
+            }
+        }
+        EXPECT_EQ(code.getLogicalParity(), expectedParity);
+        EXPECT_EQ(code.checkCorrection(), expectedParity == 0);
+    }
+}
+
+TEST(snapshot, restore_recovers_state_and_random_stream)
+{
+    int l = 6;
+    double p = 0.05;
+    RhombicCode code(l, p, p, false, 1);
+    code.generateDataError(false);
+    code.calculateSyndrome();
+    code.generateMeasError();
+    vuint64 buffer;
+    code.snapshot(buffer, 3, 5);
+    auto error = code.getError();
+    auto syndrome = code.getSyndrome();
+    int syndromeWeight = code.getSyndromeWeight();
+    int8_t logicalParity = code.getLogicalParity();
+    code.generateDataError(false);
+    auto nextError = code.getError();
+
+    code.sweep("xyz", false);
+    code.calculateSyndrome();
+    ASSERT_GT(code.countFacesFlipped(), 0);
+    int sweepIndex, sweepCount;
+    code.restore(buffer, sweepIndex, sweepCount);
+    // No sweep has run since the snapshot
+    EXPECT_EQ(code.countFacesFlipped(), 0);
+    EXPECT_TRUE(code.getFlipBits().empty());
+    EXPECT_EQ(sweepIndex, 3);
+    EXPECT_EQ(sweepCount, 5);
+    EXPECT_EQ(code.getError(), error);
+    EXPECT_EQ(code.getSyndrome(), syndrome);
+    EXPECT_EQ(code.getSyndromeWeight(), syndromeWeight);
+    EXPECT_EQ(code.getLogicalParity(), logicalParity);
+    code.generateDataError(false);
+    EXPECT_EQ(code.getError(), nextError);
+}
+
+TEST(errorHash, follows_every_change_to_the_error)
+{
+    int l = 6;
+    double p = 0.05;
+    RhombicCode code(l, p, p, false, 1);
+    RhombicCode copy(l, p, p, false, 1);
+    code.generateDataError(false);
+    code.calculateSyndrome();
+    code.sweep("xyz", false);
+    code.sweep("-xy", false);
+    // The same faces set directly hash the same, whatever route made them
+    copy.setError(std::set<int>(code.getError().begin(), code.getError().end()));
+    EXPECT_EQ(code.errorHash(), copy.errorHash());
+    vuint64 buffer;
+    code.snapshot(buffer);
+    const uint64_t hash = code.errorHash();
+    code.generateDataError(false);
+    EXPECT_NE(code.errorHash(), hash);
+    code.restore(buffer);
+    EXPECT_EQ(code.errorHash(), hash);
+    copy.setError({});
+    EXPECT_EQ(copy.errorHash(), 0);
+}
+
+TEST(snapshot, rejects_buffer_from_other_code)
+{
+    RhombicCode code(6, 0.1, 0.1, false, 1);
+    RhombicCode otherCode(4, 0.1, 0.1, false, 1);
+    vuint64 buffer;
+    otherCode.snapshot(buffer);
+    EXPECT_THROW(code.restore(buffer), std::invalid_argument);
+}
+
+TEST(generateDataError, shared_uniforms_give_nested_errors)
+{
+    int l = 6;
+    RhombicCode lowCode(l, 0.05, 0.05, false, 1);
+    RhombicCode highCode(l, 0.2, 0.2, false, 1);
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> dist(0, 1);
+    vdbl uniforms(lowCode.getNumberOfFaces());
+    for (auto &u : uniforms)
+    {
+        u = dist(engine);
+    }
+    lowCode.generateDataError(uniforms);
+    highCode.generateDataError(uniforms);
+    auto &lowError = lowCode.getError();
+    auto &highError = highCode.getError();
+    EXPECT_FALSE(lowError.empty());
+    EXPECT_GT(highError.size(), lowError.size());
+    EXPECT_TRUE(std::includes(highError.begin(), highError.end(), lowError.begin(), lowError.end()));
+}
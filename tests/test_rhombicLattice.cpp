@@ -126,15 +126,57 @@ TEST(edgeIndex, handles_valid_input)
 {
     int l = 4;
     RhombicLattice lattice = RhombicLattice(l);
+    int vertexIndex = 21;
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", 1), 84);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", 1), 21);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", 1), 71);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", 1), 82);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", -1), 0);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", -1), 65);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", -1), 19);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", -1), 6);
+}
+
+TEST(edgeIndex, excepts_vertices_not_in_lattice)
+{
+    int l = 4;
+    RhombicLattice lattice = RhombicLattice(l);
+    // Vertex 42 = (2, 2, 2, 0) has the wrong parity for this lattice
     int vertexIndex = 42;
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", 1), 294);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", 1), 296);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", 1), 300);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", 1), 298);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", -1), 595);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", -1), 709);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", -1), 629);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", -1), 606);
+    EXPECT_THROW(lattice.edgeIndex(vertexIndex, "xyz", 1), std::invalid_argument);
+    EXPECT_THROW(lattice.edgeIndex(vertexIndex, "xy", -1), std::invalid_argument);
+}
+
+TEST(sparseEdgeIndex, matches_original_numbering)
+{
+    int l = 4;
+    RhombicLattice lattice = RhombicLattice(l);
+    int vertexIndex = 21;
+    vint sparseEdges = {147, 149, 153, 151, 448, 562, 482, 459};
+    vint denseEdges = {84, 21, 71, 82, 0, 65, 19, 6};
+    for (int i = 0; i < sparseEdges.size(); ++i)
+    {
+        EXPECT_EQ(lattice.denseEdgeIndex(sparseEdges[i]), denseEdges[i]);
+        EXPECT_EQ(lattice.denseToSparseEdge(denseEdges[i]), sparseEdges[i]);
+    }
+    EXPECT_EQ(lattice.sparseEdgeIndex(vertexIndex, "xyz", 1), 147);
+    EXPECT_EQ(lattice.sparseEdgeIndex(vertexIndex, "xy", -1), 562);
+}
+
+TEST(denseToSparseEdge, inverts_dense_numbering)
+{
+    int l = 6;
+    RhombicLattice lattice = RhombicLattice(l);
+    lattice.createVertexToEdges();
+    for (const auto &edges : lattice.getVertexToEdges())
+    {
+        for (const int edge : edges)
+        {
+            EXPECT_GE(edge, 0);
+            EXPECT_LT(edge, 4 * l * l * l);
+            EXPECT_EQ(lattice.denseEdgeIndex(lattice.denseToSparseEdge(edge)), edge);
+        }
+    }
 }
 
 TEST(createFaces, correct_number_of_faces_created)
@@ -185,7 +227,7 @@ TEST(createFaces, correct_faces_created)
     {
         EXPECT_EQ(faceToVertices[i], expectedVertices[i]);
     }
-    vvint expectedEdges = {{112, 114, 448, 562}, {126, 128, 462, 576}, {147, 153, 567, 601}, {151, 254, 562, 564}, {130, 153, 459, 461}, {151, 174, 480, 482}, {165, 188, 494, 496}, {165, 268, 576, 578}, {168, 170, 504, 618}, {168, 174, 588, 622}, {182, 188, 602, 636}, {186, 289, 597, 599}, {182, 184, 518, 632}, {147, 149, 483, 597}, {186, 209, 515, 517}, {231, 233, 567, 681}, {231, 235, 672, 683}, {153, 233, 562, 566}}; // Next faceIndex = 18
+    vvint expectedEdges = {{0, 1, 64, 65}, {8, 9, 72, 73}, {68, 71, 84, 87}, {65, 66, 81, 82}, {6, 7, 70, 71}, {18, 19, 82, 83}, {26, 27, 90, 91}, {73, 74, 89, 90}, {32, 33, 96, 97}, {80, 83, 96, 99}, {88, 91, 104, 107}, {85, 86, 101, 102}, {40, 41, 104, 105}, {20, 21, 84, 85}, {38, 39, 102, 103}, {68, 69, 132, 133}, {128, 130, 132, 134}, {65, 67, 69, 71}}; // Next faceIndex = 18
     for (int i = 0; i < expectedEdges.size(); ++i)
     {
         EXPECT_EQ(faceToEdges[i], expectedEdges[i]);
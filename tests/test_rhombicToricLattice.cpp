@@ -113,26 +113,66 @@ TEST(edgeIndex, handles_valid_input)
 {
     int l = 6;
     RhombicToricLattice lattice = RhombicToricLattice(l);
-    int vertexIndex = 3;
+    int vertexIndex = 2;
     int sign = 1;
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", sign), 23);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", sign), 27);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", sign), 25);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", sign), 21);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", sign), 729);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", sign), 131);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", sign), 6);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", sign), 8);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "x", sign), 22);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "y", sign), 24);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "z", sign), 26);
 
     vertexIndex = 7;
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", -sign), 1514);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", -sign), 2820);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", -sign), 2783);
-    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", -sign), 2772);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xy", -sign), 1);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xz", -sign), 747);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "yz", -sign), 726);
+    EXPECT_EQ(lattice.edgeIndex(vertexIndex, "xyz", -sign), 720);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "x", -sign), 43);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "y", -sign), 10);
     // EXPECT_EQ(latticeBCC.edgeIndex(vertexIndex, "z", -sign), 1314);
 }
 
+TEST(edgeIndex, excepts_vertices_not_in_lattice)
+{
+    int l = 6;
+    RhombicToricLattice lattice = RhombicToricLattice(l);
+    // Vertex 3 = (3, 0, 0, 0) has odd parity so is not in the lattice
+    EXPECT_THROW(lattice.edgeIndex(3, "xy", 1), std::invalid_argument);
+    EXPECT_THROW(lattice.edgeIndex(3, "xyz", -1), std::invalid_argument);
+    // Vertex 216 = (0, 0, 0, 1) only has +xy, +xz, +yz and -xyz edges
+    EXPECT_THROW(lattice.edgeIndex(216, "xy", -1), std::invalid_argument);
+    EXPECT_THROW(lattice.edgeIndex(216, "xyz", 1), std::invalid_argument);
+}
+
+TEST(sparseEdgeIndex, matches_original_numbering)
+{
+    int l = 6;
+    RhombicToricLattice lattice = RhombicToricLattice(l);
+    vint sparseEdges = {14, 16, 20, 18, 2989, 1731, 2785, 3000};
+    vint denseEdges = {8, 729, 131, 6, 844, 125, 727, 850};
+    for (int i = 0; i < sparseEdges.size(); ++i)
+    {
+        EXPECT_EQ(lattice.denseEdgeIndex(sparseEdges[i]), denseEdges[i]);
+        EXPECT_EQ(lattice.denseToSparseEdge(denseEdges[i]), sparseEdges[i]);
+    }
+    EXPECT_EQ(lattice.sparseEdgeIndex(2, "xy", 1), 16);
+    EXPECT_EQ(lattice.sparseEdgeIndex(7, "xyz", -1), 2772);
+}
+
+TEST(denseToSparseEdge, inverts_dense_numbering)
+{
+    vint ls = {4, 6};
+    for (auto l : ls)
+    {
+        RhombicToricLattice lattice = RhombicToricLattice(l);
+        for (int edge = 0; edge < 4 * l * l * l; ++edge)
+        {
+            EXPECT_EQ(lattice.denseEdgeIndex(lattice.denseToSparseEdge(edge)), edge);
+        }
+    }
+}
+
 TEST(createFaces, handles_valid_input)
 {
     int l = 6;
@@ -143,42 +183,42 @@ TEST(createFaces, handles_valid_input)
 
     vint vertices = {0, 42, 216, 221};
     EXPECT_EQ(faceToVertices[0], vertices);
-    vint edges = {0, 4, 1516, 1547};
+    vint edges = {0, 2, 20, 22};
     EXPECT_EQ(faceToEdges[0], edges);
 
     vertices = {0, 37, 216, 246};
     EXPECT_EQ(faceToVertices[1], vertices);
-    edges = {0, 6, 1518, 1722};
+    edges = {0, 3, 120, 123};
     EXPECT_EQ(faceToEdges[1], edges);
 
     vertices = {0, 7, 216, 396};
     EXPECT_EQ(faceToVertices[2], vertices);
-    edges = {0, 2, 1514, 2772};
+    edges = {0, 1, 720, 721};
     EXPECT_EQ(faceToEdges[2], edges);
 
     vertices = {0, 186, 396, 401};
     EXPECT_EQ(faceToVertices[3], vertices);
-    edges = {2, 1308, 2809, 2813};
+    edges = {721, 723, 741, 743};
     EXPECT_EQ(faceToEdges[3], edges);
 
     vertices = {0, 181, 396, 426};
     EXPECT_EQ(faceToVertices[4], vertices);
-    edges = {2, 1271, 2984, 2986};
+    edges = {721, 722, 841, 842};
     EXPECT_EQ(faceToEdges[4], edges);
 
     vertices = {0, 31, 246, 426};
     EXPECT_EQ(faceToVertices[5], vertices);
-    edges = {6, 221, 2986, 2988};
+    edges = {122, 123, 842, 843};
     EXPECT_EQ(faceToEdges[5], edges);
 
     vertices = {167, 168, 347, 383};
     EXPECT_EQ(faceToVertices[500], vertices);
-    edges = {1169, 1171, 2429, 2683};
+    edges = {524, 525, 668, 669};
     EXPECT_EQ(faceToEdges[500], edges);
 
     vertices = {137, 167, 346, 347};
     EXPECT_EQ(faceToVertices[501], vertices);
-    edges = {965, 1171, 2424, 2428};
+    edges = {521, 523, 525, 527};
     EXPECT_EQ(faceToEdges[501], edges);
 
     vint faceIndices = {0, 1, 2, 3, 4, 5, 35, 104, 124, 201, 553, 630};
@@ -232,7 +272,7 @@ TEST(createFaces, correct_max_edge_index)
                     maxEdgeIndex = edgeIndex;
             }
         }
-        EXPECT_EQ(maxEdgeIndex, 7 * (2 * l * l * l - 1));
+        EXPECT_EQ(maxEdgeIndex, 4 * l * l * l - 1);
     }
 }
 
@@ -395,14 +435,14 @@ TEST(createUpEdgesMap, correct_edges_created)
     vvint vertexToUpEdges = upEdgesMap["-xy"];
     vint upEdges = vertexToUpEdges[0];
     std::sort(upEdges.begin(), upEdges.end());
-    vint expectedEdges = {4, 6, 555, 889};
+    vint expectedEdges = {14, 51, 61, 252};
     for (int i = 0; i < 4; ++i)
     {
         EXPECT_EQ(upEdges[i], expectedEdges[i]);
     }
     upEdges = vertexToUpEdges[64];
     std::sort(upEdges.begin(), upEdges.end());
-    expectedEdges = {0, 452, 454};
+    expectedEdges = {0, 2, 3};
     for (int i = 0; i < 4; ++i)
     {
         EXPECT_EQ(upEdges[i], expectedEdges[i]);
@@ -411,14 +451,14 @@ TEST(createUpEdgesMap, correct_edges_created)
     vertexToUpEdges = upEdgesMap["yz"];
     upEdges = vertexToUpEdges[0];
     std::sort(upEdges.begin(), upEdges.end());
-    expectedEdges = {0, 4, 555, 811};
+    expectedEdges = {0, 14, 61, 207};
     for (int i = 0; i < 4; ++i)
     {
         EXPECT_EQ(upEdges[i], expectedEdges[i]);
     }
     upEdges = vertexToUpEdges[65];
     std::sort(upEdges.begin(), upEdges.end());
-    expectedEdges = {41, 121, 455};
+    expectedEdges = {4, 5, 7};
     for (int i = 0; i < 4; ++i)
     {
         EXPECT_EQ(upEdges[i], expectedEdges[i]);
@@ -453,7 +493,7 @@ TEST(createVertexToEdges, correct_edges_created)
     int l = 6;
     RhombicToricLattice lattice = RhombicToricLattice(l);
     lattice.createVertexToEdges();
-    vint expectedEdges = {14, 16, 18, 20, 1731, 2785, 2989, 3000};
+    vint expectedEdges = {6, 8, 125, 131, 727, 729, 844, 850};
     vvint vertexToEdges = lattice.getVertexToEdges();
     vint edges = vertexToEdges[2];
     EXPECT_EQ(edges.size(), expectedEdges.size());
@@ -463,7 +503,7 @@ TEST(createVertexToEdges, correct_edges_created)
         EXPECT_EQ(edges[i], expectedEdges[i]);
     }
 
-    expectedEdges = {0, 1514, 1516, 1518};
+    expectedEdges = {0, 1, 2, 3};
     edges = vertexToEdges[216];
     EXPECT_EQ(edges.size(), expectedEdges.size());
     std::sort(edges.begin(), edges.end());
@@ -472,7 +512,7 @@ TEST(createVertexToEdges, correct_edges_created)
         EXPECT_EQ(edges[i], expectedEdges[i]);
     }
 
-    expectedEdges = {18, 55, 261, 1519};
+    expectedEdges = {4, 5, 6, 7};
     edges = vertexToEdges[217];
     EXPECT_EQ(edges.size(), expectedEdges.size());
     std::sort(edges.begin(), edges.end());
@@ -0,0 +1,52 @@
+#include "roundRecorder.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
+
+TEST(RoundRecorder, keeps_the_latest_records)
+{
+    RoundRecorder recorder(3);
+    recorder.beginTrial();
+    recorder.recordActive("xyz", 10, 20, 1);
+    recorder.recordActive("-xz", 11, 21, 2);
+    recorder.beginTrial(5);
+    recorder.recordActive("xy", 12, 22, 3);
+    recorder.recordReadout(1, "yz", 13, 23, 4);
+    ASSERT_EQ(recorder.size(), 3);
+    EXPECT_EQ(recorder.dropped(), 1);
+    EXPECT_EQ(recorder[0].trial, 0);
+    EXPECT_EQ(recorder[0].round, 1);
+    EXPECT_EQ(recorder[0].direction, 6);
+    EXPECT_EQ(recorder[1].trial, 1);
+    EXPECT_EQ(recorder[1].round, 5);
+    EXPECT_EQ(recorder[1].readout, 0);
+    EXPECT_EQ(recorder[2].round, 1);
+    EXPECT_EQ(recorder[2].readout, 1);
+    EXPECT_EQ(recorder[2].errorWeight, 13);
+    EXPECT_EQ(recorder[2].syndromeWeight, 23);
+    EXPECT_EQ(recorder[2].facesFlipped, 4);
+}
+
+TEST(RoundRecorder, writes_csv_and_binary)
+{
+    RoundRecorder recorder(4);
+    recorder.beginTrial();
+    recorder.recordActive("xyz", 10, 20, 1);
+    recorder.recordReadout(1, "unknown", 300, 2, 0);
+    std::stringstream csv;
+    recorder.writeCsv(csv);
+    EXPECT_EQ(csv.str(), "trial,phase,round,direction,error_weight,syndrome_weight,faces_flipped\n"
+                         "0,active,0,xyz,10,20,1\n"
+                         "0,readout,1,,300,2,0\n");
+    std::stringstream binary;
+    recorder.writeBinary(binary);
+    const std::string bytes = binary.str();
+    ASSERT_EQ(bytes.size(), 44);
+    EXPECT_EQ(bytes.substr(22, 10), std::string("\0\0\0\0\1\0\0\0\1\xff", 10));
+    EXPECT_EQ(bytes.substr(32, 4), std::string("\x2c\1\0\0", 4));
+}
+
+TEST(RoundRecorder, rejects_empty_buffer)
+{
+    EXPECT_THROW(RoundRecorder(0), std::invalid_argument);
+}
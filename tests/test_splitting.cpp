@@ -0,0 +1,54 @@
+#include "splitting.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+runParameters splittingParameters(const double p)
+{
+    int l = 4;
+    return {l, p, p, l, "alternating_XZ", 32 * l, "rhombic_toric", false, false, 1};
+}
+
+TEST(splittingRun, no_failures_without_errors)
+{
+    auto result = splittingRun(splittingParameters(0), 8, {1, 2}, 10, 2);
+    EXPECT_EQ(result.failureRate, 0);
+    EXPECT_EQ(result.upper, 0);
+    // Nothing reaches the first level so only the first stage runs
+    EXPECT_EQ(result.trajectories, 20);
+}
+
+TEST(splittingRun, no_levels_is_plain_monte_carlo)
+{
+    auto params = splittingParameters(0.05);
+    int rounds = 8, effort = 20, replicates = 4;
+    rnEngine = pcg32(9);
+    auto result = splittingRun(params, rounds, {}, effort, replicates);
+
+    // The same trials run one after another from the same seed
+    rnEngine = pcg32(9);
+    auto code = buildCode(params);
+    vuint64 initialState;
+    code->snapshot(initialState);
+    int failures = 0;
+    for (int i = 0; i < effort * replicates; ++i)
+    {
+        code->restore(initialState);
+        code->seedRandom(randomSeed());
+        failures += !multiHorizonRun(*code, params, {rounds})[0].success;
+    }
+    ASSERT_GT(failures, 0);
+    EXPECT_DOUBLE_EQ(result.failureRate, static_cast<double>(failures) / (effort * replicates));
+    EXPECT_EQ(result.trajectories, effort * replicates);
+    // Student t interval with replicates - 1 degrees of freedom
+    ASSERT_LT(result.upper, 1);
+    EXPECT_NEAR(result.upper - result.failureRate, studentTQuantile(0.975, replicates - 1) * result.standardError, 1e-12);
+}
+
+TEST(splittingRun, rejects_invalid_settings)
+{
+    auto params = splittingParameters(0.05);
+    EXPECT_THROW(splittingRun(params, 8, {20, 10}, 10, 2), std::invalid_argument);
+    EXPECT_THROW(splittingRun(params, 8, {0}, 10, 2), std::invalid_argument);
+    EXPECT_THROW(splittingRun(params, 8, {10}, 0, 2), std::invalid_argument);
+    EXPECT_THROW(splittingRun(params, 8, {10}, 10, 1), std::invalid_argument);
+}
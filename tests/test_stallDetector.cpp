@@ -0,0 +1,65 @@
+#include "stallDetector.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+TEST(StallDetector, detects_repeated_state)
+{
+    StallDetector detector(5, true);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(3, 12), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 10), StallDetector::repeatedState);
+}
+
+TEST(StallDetector, ignores_repeats_unless_watched)
+{
+    StallDetector detector(5);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 9), StallDetector::progressing);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+}
+
+TEST(StallDetector, zero_patience_never_stalls)
+{
+    StallDetector detector(0, true);
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(detector.update(i, 10), StallDetector::progressing);
+    }
+}
+
+TEST(StallDetector, zero_patience_still_detects_repeats)
+{
+    StallDetector detector(0, true);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::repeatedState);
+}
+
+TEST(StallDetector, detects_no_decrease)
+{
+    int patience = 3;
+    StallDetector detector(patience);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 8), StallDetector::progressing);
+    EXPECT_EQ(detector.update(3, 9), StallDetector::progressing);
+    EXPECT_EQ(detector.update(4, 8), StallDetector::progressing);
+    EXPECT_EQ(detector.update(5, 12), StallDetector::noProgress);
+}
+
+TEST(StallDetector, new_minimum_resets_patience)
+{
+    StallDetector detector(2);
+    EXPECT_EQ(detector.update(1, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(2, 10), StallDetector::progressing);
+    EXPECT_EQ(detector.update(3, 9), StallDetector::progressing);
+    EXPECT_EQ(detector.update(4, 9), StallDetector::progressing);
+    EXPECT_EQ(detector.update(5, 9), StallDetector::noProgress);
+    detector.reset();
+    EXPECT_EQ(detector.update(1, 9), StallDetector::progressing);
+}
+
+TEST(StallDetector, rejects_negative_patience)
+{
+    EXPECT_THROW(StallDetector detector(-1), std::invalid_argument);
+}
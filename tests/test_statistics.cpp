@@ -0,0 +1,26 @@
+#include "statistics.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+TEST(normalQuantile, matches_tables)
+{
+    EXPECT_NEAR(normalQuantile(0.5), 0, 1e-12);
+    EXPECT_NEAR(normalQuantile(0.975), 1.959963985, 1e-9);
+    EXPECT_NEAR(normalQuantile(0.025), -1.959963985, 1e-9);
+    EXPECT_NEAR(normalQuantile(0.999), 3.090232306, 1e-9);
+    EXPECT_NEAR(normalQuantile(1e-6), -4.753424309, 1e-8);
+    EXPECT_THROW(normalQuantile(0), std::invalid_argument);
+    EXPECT_THROW(normalQuantile(1), std::invalid_argument);
+}
+
+TEST(studentTQuantile, matches_tables)
+{
+    EXPECT_NEAR(studentTQuantile(0.975, 1), 12.7062047, 1e-6);
+    EXPECT_NEAR(studentTQuantile(0.975, 2), 4.3026527, 1e-6);
+    EXPECT_NEAR(studentTQuantile(0.975, 3), 3.1824463, 5e-3);
+    EXPECT_NEAR(studentTQuantile(0.975, 5), 2.5705818, 1e-3);
+    EXPECT_NEAR(studentTQuantile(0.975, 10), 2.2281389, 1e-4);
+    EXPECT_NEAR(studentTQuantile(0.975, 30), 2.0422725, 1e-5);
+    EXPECT_NEAR(studentTQuantile(0.025, 10), -2.2281389, 1e-4);
+    EXPECT_THROW(studentTQuantile(0.975, 0), std::invalid_argument);
+}
@@ -0,0 +1,93 @@
+#include "rhombicCode.h"
+#include "cubicCode.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <new>
+
+// Count heap allocations made while countAllocations is set.
+// Lives in its own executable because it replaces the global operator new.
+namespace
+{
+bool countAllocations = false;
+int allocations = 0;
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    if (countAllocations)
+    {
+        ++allocations;
+    }
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+int countSweepAllocations(Code &code, const std::string &direction, bool greedy)
+{
+    allocations = 0;
+    countAllocations = true;
+    code.sweep(direction, greedy);
+    countAllocations = false;
+    return allocations;
+}
+
+TEST(sweep, no_allocations_rhombic_toric)
+{
+    int l = 4;
+    double p = 0.1;
+    RhombicCode code(l, p, p, false, 1);
+    code.setError({44, 45, 151});
+    code.calculateSyndrome();
+    EXPECT_EQ(countSweepAllocations(code, "xyz", true), 0);
+    EXPECT_EQ(code.getError(), std::set<int>({44, 151}));
+}
+
+TEST(sweep, no_allocations_cubic_boundaries)
+{
+    int l = 6;
+    double p = 0.1;
+    CubicCode code(l, p, p, true, 2);
+    auto &lattice = code.getLattice();
+    int vertexIndex = lattice.coordinateToIndex({2, 2, 2, 0});
+    vint vertices = code.faceVertices(vertexIndex, {"x", "y", "y"});
+    code.setError({lattice.findFace(vertices)});
+    code.calculateSyndrome();
+    EXPECT_EQ(countSweepAllocations(code, "xyz", true), 0);
+    EXPECT_TRUE(code.getError().empty());
+    for (const int value : code.getSyndrome())
+    {
+        EXPECT_EQ(value, 0);
+    }
+}
+
+// Sweeps that flip clean faces into the error
+TEST(sweep, no_allocations_adding_faces)
+{
+    int l = 4;
+    double p = 0.1;
+    RhombicCode rhombicCode(l, p, p, false, 1);
+    rhombicCode.setError({0, 1});
+    rhombicCode.calculateSyndrome();
+    EXPECT_EQ(countSweepAllocations(rhombicCode, "xyz", true), 0);
+    EXPECT_EQ(rhombicCode.getError(), std::set<int>({65}));
+
+    CubicCode cubicCode(l, p, p, false, 1);
+    cubicCode.setError({0, 1});
+    cubicCode.calculateSyndrome();
+    EXPECT_EQ(countSweepAllocations(cubicCode, "xyz", true), 0);
+    EXPECT_EQ(cubicCode.getError(), std::set<int>({0, 1, 2, 5}));
+}
@@ -0,0 +1,73 @@
+#include "threshold.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+TEST(crossingSide, separates_significant_differences)
+{
+    EXPECT_EQ(crossingSide(0, 100, 0, 100), -1);
+    EXPECT_EQ(crossingSide(100, 100, 100, 100), 1);
+    EXPECT_EQ(crossingSide(30, 100, 10, 100), -1);
+    EXPECT_EQ(crossingSide(10, 100, 30, 100), 1);
+    EXPECT_EQ(crossingSide(20, 100, 22, 100), 0);
+}
+
+TEST(crossingSide, critical_value_widens_undecided_range)
+{
+    EXPECT_EQ(crossingSide(10, 100, 22, 100), 1);
+    EXPECT_EQ(crossingSide(10, 100, 22, 100, 2.5), 0);
+}
+
+TEST(thresholdSearch, bracket_narrows)
+{
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    // With four cycles the curves of L = 4 and 8 cross between the ends
+    auto result = thresholdSearch(common, {8, 4}, 0.005, 0.1, 4, 0.03, 50, 300);
+    ASSERT_GE(result.steps.size(), 3);
+    EXPECT_DOUBLE_EQ(result.steps[0].p, 0.005);
+    EXPECT_EQ(result.steps[0].verdict, -1);
+    EXPECT_DOUBLE_EQ(result.steps[1].p, 0.1);
+    EXPECT_EQ(result.steps[1].verdict, 1);
+    long long trials = 0;
+    for (const auto &step : result.steps)
+    {
+        EXPECT_LE(step.trials[0], 300);
+        EXPECT_EQ(step.trials[0], step.trials[1]);
+        trials += step.trials[0] + step.trials[1];
+    }
+    EXPECT_EQ(result.trials, trials);
+    // Every midpoint moved the end on its side
+    for (int i = 2; i < static_cast<int>(result.steps.size()); ++i)
+    {
+        const auto &step = result.steps[i];
+        if (step.verdict < 0)
+        {
+            EXPECT_LE(step.p, result.lower);
+        }
+        else if (step.verdict > 0)
+        {
+            EXPECT_GE(step.p, result.upper);
+        }
+    }
+    EXPECT_LT(result.lower, result.upper);
+    if (result.resolved)
+    {
+        EXPECT_LE(result.upper - result.lower, 0.03);
+        EXPECT_DOUBLE_EQ(result.estimate, (result.lower + result.upper) / 2);
+    }
+}
+
+TEST(thresholdSearch, rejects_bracket_without_crossing)
+{
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    // Far below threshold nothing fails, so both ends are placed below
+    EXPECT_THROW(thresholdSearch(common, {6, 4}, 0, 0.001, 4, 0.0002, 50, 200), std::invalid_argument);
+}
+
+TEST(thresholdSearch, rejects_invalid_settings)
+{
+    runParameters common{0, 0, 0, 0, "alternating_XZ", 0, "rhombic_toric", false, false, 1};
+    EXPECT_THROW(thresholdSearch(common, {4}, 0.01, 0.1, 4, 0.01, 10, 100), std::invalid_argument);
+    EXPECT_THROW(thresholdSearch(common, {4, 6}, 0.1, 0.01, 4, 0.01, 10, 100), std::invalid_argument);
+    EXPECT_THROW(thresholdSearch(common, {4, 6}, 0.01, 0.1, 4, 0, 10, 100), std::invalid_argument);
+    EXPECT_THROW(thresholdSearch(common, {4, 6}, 0.01, 0.1, 4, 0.01, 10, 5), std::invalid_argument);
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include "threshold.h"
+#include <chrono>
+#include <string>
+#include <sstream>
+
+// Search a p bracket for the threshold. Takes the lattice sizes as a comma
+// separated list, the ends of the p bracket, the number of cycles, then the
+// lattice type, sweep limit, sweep schedule, timeout, greedy, correlated and
+// sweep rate arguments of SweepDecoder (a sweep limit or timeout of 0 uses
+// the data_generator.py default for each L), then the bracket width to stop
+// at, the trials per batch and the trial budget per L at each p.
+int main(int argc, char *argv[])
+{
+    if (argc < 15)
+    {
+        std::cout << "Fewer than fourteen arguments" << std::endl;
+        for (int i = 0; i < argc; ++i)
+        {
+            std::cout << "Argument " << i << " = " << argv[i] << std::endl;
+        }
+        return 1;
+    }
+
+    vint ls;
+    std::stringstream ssl(argv[1]);
+    std::string l;
+    while (std::getline(ssl, l, ','))
+    {
+        ls.push_back(std::atoi(l.c_str()));
+    }
+    double lower = std::atof(argv[2]);
+    double upper = std::atof(argv[3]);
+    int cycles = std::atoi(argv[4]);
+    runParameters common;
+    common.l = 0;
+    common.p = 0;
+    common.q = 0;
+    common.latticeType = argv[5];
+    common.sweepLimit = std::atoi(argv[6]);
+    common.sweepSchedule = argv[7];
+    common.timeout = std::atoi(argv[8]);
+    std::stringstream ssg(argv[9]);
+    if (!(ssg >> std::boolalpha >> common.greedy))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    std::stringstream ssc(argv[10]);
+    if (!(ssc >> std::boolalpha >> common.correlatedErrors))
+    {
+        std::cerr << "Incorrect argument provided (boolean)." << std::endl;
+        return 1;
+    }
+    common.sweepRate = std::atoi(argv[11]);
+    double precision = std::atof(argv[12]);
+    int batchSize = std::atoi(argv[13]);
+    int budget = std::atoi(argv[14]);
+
+    // One line per sampled p: p, verdict, failures/trials for each L
+    auto start = std::chrono::high_resolution_clock::now();
+    thresholdResult result = thresholdSearch(common, ls, lower, upper, cycles, precision, batchSize, budget, &std::cout);
+    auto finish = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = finish - start;
+
+    std::cout << result.estimate << ", " // Threshold estimate
+              << result.lower << ", " // Bracket
+              << result.upper << ", "
+              << result.resolved << ", " // Bracket reached the requested width
+              << result.trials << ", " // Trials over the whole search
+              << elapsed.count() // "s"
+              << std::endl;
+
+    return 0;
+}